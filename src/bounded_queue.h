@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ */
+
+#ifndef BOUNDED_QUEUE_HH
+#define BOUNDED_QUEUE_HH
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+ * Thread safe queue with limited capacity. Push blocks when queue is full,
+ * Pop blocks when queue is empty and not closed yet.
+ */
+template <typename T>
+class BoundedQueue {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param  capacity  max number of stored elements
+         */
+        BoundedQueue(size_t capacity) : capacity(capacity), closed(false) {}
+
+        /**
+         * Adds element to the end of queue. Waits while queue is full.
+         *
+         * @param  element  added element
+         */
+        void Push(T element) {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->not_full.wait(lock, [this] { return this->queue.size() < this->capacity; });
+
+            this->queue.push_back(element);
+            this->not_empty.notify_one();
+        }
+
+        /**
+         * Takes element from the beginning of queue. Waits while queue is empty.
+         *
+         * @param   element  taken element
+         * @return           false if queue is closed and empty
+         */
+        bool Pop(T * element) {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->not_empty.wait(lock, [this] { return !this->queue.empty() || this->closed; });
+
+            if (this->queue.empty())
+                return false;
+
+            *element = this->queue.front();
+            this->queue.pop_front();
+            this->not_full.notify_one();
+
+            return true;
+        }
+
+        /**
+         * Closes queue. Waiting consumers are woken up once queue is empty.
+         */
+        void Close() {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->closed = true;
+            this->not_empty.notify_all();
+        }
+
+    private:
+        std::deque<T> queue;
+        size_t capacity;
+        bool closed;
+
+        std::mutex mutex;
+        std::condition_variable not_empty;
+        std::condition_variable not_full;
+};
+
+#endif //BOUNDED_QUEUE_HH
@@ -13,14 +13,28 @@
 #include "branch_bound.h"
 
 int main(int argc, char** argv) {
+    Options options;
     
-    if (argc >= MIN_PARAM) {
-        char * file_name = argv[1];
-        auto inst = new Instances(file_name);
-        SolveBranchBound(inst);
-        inst->PrintSolutions();
+    if (ParseOptions(argc, argv, MIN_PARAM, &options)) {
+        char * file_name = options.params.at(0);
+        BranchBoundSettings settings = ParseSettings(options.kernel);
+
+        if (options.stream) {
+            auto solver = [settings](const InstanceView & view, Instance * inst) {
+                // every solver thread of pipeline keeps one table for all its instances
+                static thread_local std::unique_ptr<TranspositionTable> table(CreateTable(settings));
+                SolveBranchBoundInstance(view, inst, settings, table.get());
+            };
+
+            SolveStream(file_name, solver, options.threads, options.binary);
+        }
+        else {
+            auto inst = new Instances(file_name, options.ids);
+            SolveBranchBound(inst, settings, options.threads);
+            inst->PrintSolutions(options.binary);
 
-        delete inst;
+            delete inst;
+        }
     }
 
     return EXIT_SUCCESS;
@@ -29,20 +43,438 @@ int main(int argc, char** argv) {
 /**
  * Solves knapsack problem using Branch & Bound method.
  *
- * @param  inst  all loaded instances
+ * @param  inst      all loaded instances
+ * @param  settings  kernel and its settings
+ * @param  threads   number of threads of parallel kernel, 0 for all cores
+ */
+void SolveBranchBound(Instances * inst, const BranchBoundSettings & settings, int threads) {
+    const InstanceBatch & batch = inst->GetBatch();
+
+    if (settings.kernel == KERNEL_PARALLEL) {
+        WorkStealingPool pool(threads);
+
+        // dive is not interrupted by other tasks, so every worker has own table
+        std::vector<TranspositionTable> tables;
+
+        if (settings.table > 0) {
+            tables.reserve(pool.Size());
+
+            for (int i = 0; i < pool.Size(); ++i)
+                tables.emplace_back(settings.table);
+        }
+
+        // one instance at a time is solved by all threads
+        for (size_t i = 0; i < batch.Size(); ++i) {
+            Instance * result = inst->GetInstance(i);
+            result->solution = EvaluateParallel(batch.View(i), result, settings, &pool, &tables);
+        }
+
+        return;
+    }
+
+    // table is allocated once, instances only invalidate its entries
+    std::unique_ptr<TranspositionTable> table(CreateTable(settings));
+
+    for (size_t i = 0; i < batch.Size(); ++i)
+        SolveBranchBoundInstance(batch.View(i), inst->GetInstance(i), settings, table.get());
+}
+
+/**
+ * Solves one instance of knapsack problem by Branch & Bound method.
+ * Instances are already solved in parallel by pipeline, so parallel
+ * kernel searches one instance depth first.
+ *
+ * @param  view      instance of knapsack problem
+ * @param  inst      instance where solution is stored
+ * @param  settings  kernel and its settings
+ * @param  table     transposition table reused by instances, NULL if disabled
+ */
+void SolveBranchBoundInstance(const InstanceView & view,
+                              Instance * inst,
+                              const BranchBoundSettings & settings,
+                              TranspositionTable * table) {
+    if (settings.kernel == KERNEL_DEPTH || settings.kernel == KERNEL_PARALLEL)
+        inst->solution = SearchDepth(view, inst, settings.bound, table);
+    else if (settings.kernel == KERNEL_BEST)
+        inst->solution = EvaluateBest(view, inst, settings, table);
+    else
+        inst->solution = EvaluateDispatch(view, inst);
+}
+
+/**
+ * Creates transposition table of size given by settings.
+ *
+ * @param   settings  kernel and its settings
+ * @return            new table, NULL if table is disabled
+ */
+TranspositionTable * CreateTable(const BranchBoundSettings & settings) {
+    if (settings.table == 0 || settings.kernel == KERNEL_BREADTH)
+        return NULL;
+
+    return new TranspositionTable(settings.table);
+}
+
+/**
+ * Translates comma separated kernel and settings given by -k option.
+ *
+ * @param   list  kernel and settings, NULL for default ones
+ * @return        parsed settings
+ */
+BranchBoundSettings ParseSettings(const char * list) {
+    BranchBoundSettings settings = {KERNEL_BREADTH, BOUND_DANTZIG, BEST_FIRST_MEMORY_LIMIT, 0};
+
+    if (list == NULL)
+        return settings;
+
+    std::stringstream stream(list);
+    std::string name;
+
+    while (std::getline(stream, name, ',')) {
+        if (name == "breadth")
+            settings.kernel = KERNEL_BREADTH;
+        else if (name == "depth")
+            settings.kernel = KERNEL_DEPTH;
+        else if (name == "best")
+            settings.kernel = KERNEL_BEST;
+        else if (name == "parallel")
+            settings.kernel = KERNEL_PARALLEL;
+        else if (name == "dantzig")
+            settings.bound = BOUND_DANTZIG;
+        else if (name == "u2")
+            settings.bound = BOUND_MARTELLO_TOTH;
+        else if (name.compare(0, 7, "memory=") == 0)
+            settings.memory = ParseMegabytes(name, 7);
+        else if (name.compare(0, 6, "table=") == 0)
+            settings.table = ParseMegabytes(name, 6);
+        else {
+            std::cerr << "Unknown kernel " << name << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    return settings;
+}
+
+/**
+ * Translates size of memory of "name=<MB>" setting to bytes. Settings
+ * without positive number of megabytes end program.
+ *
+ * @param   setting  setting from -k option
+ * @param   prefix   length of "name=" part
+ * @return           size of memory in bytes
+ */
+size_t ParseMegabytes(const std::string & setting, size_t prefix) {
+    const char * value = setting.c_str() + prefix;
+    char * end;
+    errno = 0;
+    long megabytes = strtol(value, &end, 10);
+
+    if (end == value || *end != '\0' || errno == ERANGE || megabytes <= 0 ||
+        (unsigned long)megabytes > (SIZE_MAX >> 20)) {
+        std::cerr << "Invalid setting " << setting << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    return (size_t)megabytes << 20;
+}
+
+/**
+ * Chooses search with the narrowest mask for number of items of instance,
+ * nodes with 32 bit mask are smaller, so more of them fit into cache.
+ * Instances with more than 64 items are searched with binary vectors.
+ *
+ * @param  view  instance of knapsack problem
+ * @param  inst  instance where sum of costs is stored
+ * @return       solution of instance
+ */
+SolutionBits EvaluateDispatch(const InstanceView & view, Instance * inst) {
+    if (view.size <= 32)
+        return EvaluateFixed<uint32_t>(view, inst);
+    else if (view.size <= 64)
+        return EvaluateFixed<uint64_t>(view, inst);
+
+    inst->weight.assign(view.weight, view.weight + view.size);
+    inst->cost.assign(view.cost, view.cost + view.size);
+
+    return Evaluate(inst, view.capacity, view.size);
+}
+
+/**
+ * Breadth first search of the same tree as Evaluate for instances with at
+ * most as many items as bits of Mask. Nodes hold mask of selected items
+ * together with their cost and weight, costs and weights of items are
+ * copied to fixed arrays and remaining cost is read from suffix sums, so
+ * no node is walked item by item.
+ *
+ * @param  view  instance of knapsack problem with at most N items
+ * @param  inst  instance where sum of costs is stored
+ * @return       solution of instance
+ */
+template <class Mask>
+SolutionBits EvaluateFixed(const InstanceView & view, Instance * inst) {
+    const int N = sizeof(Mask) * 8;
+    int size = view.size;
+    int capacity = view.capacity;
+    int cost[N];
+    int weight[N];
+    int remaining[N + 1];
+
+    remaining[size] = 0;
+
+    for (int i = size - 1; i >= 0; --i) {
+        cost[i] = view.cost[i];
+        weight[i] = view.weight[i];
+        remaining[i] = remaining[i + 1] + cost[i];
+    }
+
+    std::queue<BranchNode<Mask> > queue;
+    BranchNode<Mask> root = {0, 0, 0, EMPTY};
+    queue.push(root);
+
+    BranchNode<Mask> best = root;
+    BranchNode<Mask> node;
+
+    while (!queue.empty()) {
+        node = queue.front();
+        queue.pop();
+
+        if (node.cost >= best.cost)
+            best = node;
+
+        // COST bounding
+        if (node.cost + remaining[node.position + 1] < best.cost)
+            continue;
+
+        for (int i = node.position + 1; i < size; ++i) {
+            // WEIGHT bounding
+            if (node.weight + weight[i] <= capacity) {
+                BranchNode<Mask> next = {(Mask)(node.mask | ((Mask)1 << i)),
+                                         node.cost + cost[i],
+                                         node.weight + weight[i],
+                                         i};
+                queue.push(next);
+            }
+        }
+    }
+
+    // stores sum cost of all used items
+    inst->sum_cost = best.cost;
+
+    return SolutionBits::FromMask(best.mask, size);
+}
+
+/**
+ * Best first search of include/exclude tree of items sorted by ratio.
+ * Node with the highest upper bound is expanded first, so search ends as
+ * soon as no node can beat the best solution. Nodes are kept in arena
+ * together with masks of selected items. When arena reaches memory limit,
+ * remaining nodes are searched depth first one by one in order of their
+ * bounds.
+ *
+ * @param  view      instance of knapsack problem
+ * @param  inst      instance where sum of costs is stored
+ * @param  settings  bound and memory limit of arena
+ * @param  table     transposition table cleared before search, NULL if disabled
+ * @return           solution of instance
  */
-void SolveBranchBound(Instances * inst) {
-    int capacity = inst->GetCapacity();
-    int volume = inst->GetVolume();
-    int max_items = inst->GetMaxItems();
+SolutionBits EvaluateBest(const InstanceView & view,
+                          Instance * inst,
+                          const BranchBoundSettings & settings,
+                          TranspositionTable * table) {
+    int size = view.size;
+    RatioItems items = SortByRatio(view);
 
-    std::vector<Instance *> all_instances =  inst->GetAllInstances();
-    std::vector<bool> solution;
+    Incumbent best = {SolutionBits(size), 0};
+    best.cost = GreedySolution(items, view, &best.solution);
 
-    for (auto inst_it = all_instances.begin(); inst_it != all_instances.end(); ++inst_it) {
-        solution = Evaluate(*inst_it, capacity, max_items);
-        (*inst_it)->solution = solution;
+    SolutionBits current(size);
+    NodeArena arena(size, settings.memory);
+
+    // queue holds at most one entry per slot of arena
+    std::vector<QueueEntry> entries;
+    entries.reserve(arena.Capacity());
+    std::priority_queue<QueueEntry> queue(std::less<QueueEntry>(), std::move(entries));
+    bool diving = false;
+
+    // stored nodes are searched later or bounded, so they share table with dives
+    bool limited = view.volume < size;
+
+    if (table != NULL)
+        table->Clear();
+
+    SearchNode root = {0, 0, 0, 0, 0};
+    root.bound = UpperBound(items, 0, view.capacity, settings.bound);
+
+    if (root.bound > best.cost && size > 0) {
+        QueueEntry entry = {root.bound, arena.Allocate(root, current.Words())};
+        queue.push(entry);
     }
+
+    while (!queue.empty()) {
+        QueueEntry top = queue.top();
+        queue.pop();
+
+        // the other nodes have lower bounds as well
+        if (top.bound <= best.cost)
+            break;
+
+        SearchNode node = arena.Node(top.slot);
+        memcpy(current.Words(), arena.Mask(top.slot), current.WordCount() * sizeof(uint64_t));
+        arena.Release(top.slot);
+
+        if (diving) {
+            DiveDepth(items, view, settings.bound, node, &current, &best, table);
+            continue;
+        }
+
+        int depth = node.depth;
+
+        for (int include = 1; include >= 0; --include) {
+            SearchNode child = node;
+            child.depth = depth + 1;
+
+            if (include) {
+                // WEIGHT bounding
+                if (node.weight + items.weight[depth] > view.capacity || node.count >= view.volume)
+                    continue;
+
+                current.Set(depth, true);
+                child.cost += items.cost[depth];
+                child.weight += items.weight[depth];
+                ++child.count;
+            }
+
+            best.Offer(child.cost, current);
+
+            child.bound = child.cost + UpperBound(items, child.depth, view.capacity - child.weight, settings.bound);
+
+            // COST bounding, leaves are not stored
+            bool searched = child.depth < size && child.bound > best.cost;
+
+            if (searched && table != NULL)
+                searched = !table->Dominated(child.depth, child.weight, limited ? child.count : 0, child.cost);
+
+            if (searched) {
+                if (arena.Full()) {
+                    diving = true;
+                    DiveDepth(items, view, settings.bound, child, &current, &best, table);
+                }
+                else {
+                    QueueEntry entry = {child.bound, arena.Allocate(child, current.Words())};
+                    queue.push(entry);
+                }
+            }
+
+            current.Set(depth, false);
+        }
+    }
+
+    // stores sum cost of all used items
+    inst->sum_cost = best.cost;
+
+    return RestoreOrder(items, best.solution);
+}
+
+/**
+ * Depth first search of include/exclude tree of items sorted by ratio
+ * shared by threads of pool. Subtrees in the top levels of tree are
+ * submitted as tasks, so idle threads steal them, the deeper ones are
+ * searched depth first by thread which reached them. Cost of the best
+ * solution is shared by all threads and they bound by it immediately.
+ *
+ * @param  view      instance of knapsack problem
+ * @param  inst      instance where sum of costs is stored
+ * @param  settings  bound of nodes
+ * @param  pool      threads searching subtrees
+ * @param  tables    transposition tables of workers cleared before search,
+ *                   empty if disabled
+ * @return           solution of instance
+ */
+SolutionBits EvaluateParallel(const InstanceView & view,
+                              Instance * inst,
+                              const BranchBoundSettings & settings,
+                              WorkStealingPool * pool,
+                              std::vector<TranspositionTable> * tables) {
+
+    RatioItems items = SortByRatio(view);
+
+    SolutionBits greedy(view.size);
+    int greedy_cost = GreedySolution(items, view, &greedy);
+    SharedIncumbent best(greedy, greedy_cost);
+
+    SearchNode root = {0, 0, 0, 0, 0};
+    SolutionBits current(view.size);
+    LpBound bound = settings.bound;
+
+    for (auto & table : *tables)
+        table.Clear();
+
+    pool->Submit([&items, &view, bound, root, current, &best, tables, pool](int worker) {
+        SearchSubtree(items, view, bound, root, current, &best, tables, worker, pool);
+    });
+
+    pool->Wait();
+
+    // stores sum cost of all used items
+    inst->sum_cost = best.Cost();
+
+    return RestoreOrder(items, best.Solution());
+}
+
+/**
+ * Searches subtree of given node by task of pool. Above split depth, the
+ * subtree excluding item of node is submitted as a new task and the task
+ * continues with subtree including it.
+ *
+ * @param  items    items sorted by ratio
+ * @param  view     instance of knapsack problem
+ * @param  bound    upper bound of cost of nodes
+ * @param  node     root of searched subtree
+ * @param  current  selected items of node
+ * @param  best     the best solution shared by all tasks
+ * @param  tables   transposition tables of workers, empty if disabled
+ * @param  worker   worker running task
+ * @param  pool     threads searching subtrees
+ */
+void SearchSubtree(const RatioItems & items,
+                   const InstanceView & view,
+                   LpBound bound,
+                   SearchNode node,
+                   SolutionBits current,
+                   SharedIncumbent * best,
+                   std::vector<TranspositionTable> * tables,
+                   int worker,
+                   WorkStealingPool * pool) {
+
+    while (node.depth < view.size && node.depth < PARALLEL_SPLIT_DEPTH) {
+        int depth = node.depth;
+        best->Offer(node.cost, current);
+
+        // COST bounding
+        if (node.cost + UpperBound(items, depth, view.capacity - node.weight, bound) <= best->Cost())
+            return;
+
+        SearchNode exclude = node;
+        exclude.depth = depth + 1;
+
+        // WEIGHT bounding, only the subtree excluding item is left
+        if (node.weight + items.weight[depth] > view.capacity || node.count >= view.volume) {
+            node = exclude;
+            continue;
+        }
+
+        pool->Submit([&items, &view, bound, exclude, current, best, tables, pool](int worker) {
+            SearchSubtree(items, view, bound, exclude, current, best, tables, worker, pool);
+        });
+
+        current.Set(depth, true);
+        node.cost += items.cost[depth];
+        node.weight += items.weight[depth];
+        ++node.count;
+        ++node.depth;
+    }
+
+    DiveDepth(items, view, bound, node, &current, best, tables->empty() ? NULL : &(*tables)[worker]);
 }
 
 /**
@@ -53,18 +485,18 @@ void SolveBranchBound(Instances * inst) {
  * @param  max_items  number of allowed items in knapsack
  * @return            solution of particular instances
  */
-std::vector<bool> Evaluate(Instance * inst, int capacity, int max_items) {
+SolutionBits Evaluate(Instance * inst, int capacity, int max_items) {
     // create queue and insert distribution with empty knapsack
-    std::queue<std::vector<bool>> queue; 
+    std::queue<SolutionBits> queue; 
     queue.push(CreateEmptyKnapsack(max_items));
 
     // temporary variables
     int tmp_pos;
-    std::vector<bool> tmp_item;
+    SolutionBits tmp_item;
 
     // best solution variables
     int tmp_best_cost = 0;
-    std::vector<bool> tmp_best_distribution;
+    SolutionBits tmp_best_distribution;
 
     // current, remaining cost
     int cc;
@@ -117,9 +549,9 @@ std::vector<bool> Evaluate(Instance * inst, int capacity, int max_items) {
  * @param  position   position of new added item
  * @return            new distribution of items in knapsack
  */
-std::vector<bool> NextItem(std::vector<bool> * inst_item, int position) {
-    std::vector<bool> tmp_inst = *inst_item;
-    tmp_inst.at(position) = 1;
+SolutionBits NextItem(SolutionBits * inst_item, int position) {
+    SolutionBits tmp_inst = *inst_item;
+    tmp_inst.Set(position, 1);
 
     return tmp_inst;
 }
@@ -130,18 +562,16 @@ std::vector<bool> NextItem(std::vector<bool> * inst_item, int position) {
  * @param   inst_item  distribution of items in knapsack
  * @return             position of last binary one
  */
-int GetPosition(std::vector<bool> * inst_item) {
-    int tmp_index = 0;
-    int index = EMPTY;
-
-    for (auto it = inst_item->begin(); it != inst_item->end(); ++it) {
-        if (*it == 1)
-            index = tmp_index;
+int GetPosition(SolutionBits * inst_item) {
+    // the highest nonzero word
+    for (int j = inst_item->WordCount() - 1; j >= 0; --j) {
+        uint64_t w = inst_item->Words()[j];
 
-        ++tmp_index;
+        if (w != 0)
+            return j * SOLUTION_WORD_BITS + (SOLUTION_WORD_BITS - 1 - __builtin_clzll(w));
     }
 
-    return index;
+    return EMPTY;
 }
 
 /**
@@ -149,9 +579,9 @@ int GetPosition(std::vector<bool> * inst_item) {
  *
  * @param  bv  binary vector
  */
-void PrintBinaryVector(std::vector<bool> * bv) {
-    for (auto it = bv->begin(); it != bv->end(); ++it)
-        std::cout << *it;
+void PrintBinaryVector(SolutionBits * bv) {
+    for (size_t i = 0; i < bv->Size(); ++i)
+        std::cout << bv->Get(i);
 
     std::cout << std::endl;
 }
@@ -162,14 +592,8 @@ void PrintBinaryVector(std::vector<bool> * bv) {
  * @param   size  size of kanpsack
  * @return        generated empty knapsack
  */
-std::vector<bool> CreateEmptyKnapsack(int size) {
-    std::vector<bool> knapsack;
-
-    for (int i = 0; i < size; ++i) {
-        knapsack.push_back(0);
-    }
-
-    return knapsack;
+SolutionBits CreateEmptyKnapsack(int size) {
+    return SolutionBits(size);
 }
 
 /**
@@ -179,17 +603,8 @@ std::vector<bool> CreateEmptyKnapsack(int size) {
  * @param   inst          holds information about costs and weights of items
  * @return                cost of all items in knapsack
  */
-int ComputeCurrentCost(std::vector<bool> * distribution, Instance * inst) {
-    int cost = 0;
-    int index = 0;
-
-    for (auto it = distribution->begin(); it != distribution->end(); ++it) {
-        if (*it == 1) cost += inst->cost.at(index);
-
-        ++index;
-    }
-
-    return cost;
+int ComputeCurrentCost(SolutionBits * distribution, Instance * inst) {
+    return distribution->Dot(inst->cost.data());
 }
 
 /**
@@ -199,16 +614,11 @@ int ComputeCurrentCost(std::vector<bool> * distribution, Instance * inst) {
  * @param   inst          holds information about costs and weights of items
  * @return                cost of remaining items
  */
-int ComputeRemainingCost(std::vector<bool> * distribution, Instance * inst) {
+int ComputeRemainingCost(SolutionBits * distribution, Instance * inst) {
     int cost = 0;
-    int index = 0;
-    int offset = GetPosition(distribution) + 1;
 
-    for (auto it = distribution->begin() + offset; it != distribution->end(); ++it) {
-            cost += inst->cost.at(offset);
-
-        ++offset;
-    }
+    for (size_t i = GetPosition(distribution) + 1; i < distribution->Size(); ++i)
+        cost += inst->cost.at(i);
 
     return cost;
 }
@@ -220,15 +630,6 @@ int ComputeRemainingCost(std::vector<bool> * distribution, Instance * inst) {
  * @param   inst          holds information about costs and weights of items
  * @return                weight of all items in knapsack
  */
-int ComputeCurrentWeight(std::vector<bool> * distribution, Instance * inst) {
-    int weight = 0;
-    int index = 0;
-
-    for (auto it = distribution->begin(); it != distribution->end(); ++it) {
-        if (*it == 1) weight += inst->weight.at(index);
-
-        ++index;
-    }
-
-    return weight;
+int ComputeCurrentWeight(SolutionBits * distribution, Instance * inst) {
+    return distribution->Dot(inst->weight.data());
 }
@@ -8,20 +8,266 @@
 #define BRANCHBOUND_HH
 
 #define MIN_PARAM   2
-#define EMPTY      -1
 
+// default memory limit of nodes of best first search in bytes
+#define BEST_FIRST_MEMORY_LIMIT (1 << 28)
+
+// nodes of parallel search above this depth are split to tasks
+#define PARALLEL_SPLIT_DEPTH 12
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <queue>
+#include <sstream>
+#include <string>
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include "depth_search.h"
 #include "instances.h"
+#include "options.h"
+#include "pipeline.h"
+#include "work_stealing.h"
+
+/**
+ * Kernels of branch and bound selected by -k option. Option takes comma
+ * separated list of kernel and its settings, e.g. "depth,u2".
+ *
+ * breadth  breadth first search of subsets ordered by the last selected
+ *          item (default)
+ * depth    depth first search of include/exclude tree of items sorted by
+ *          ratio of cost/weight, state of node is updated and restored in
+ *          place, memory is linear in number of items
+ * best     best first search of the same tree, nodes with the highest
+ *          upper bound are expanded first; when nodes reach memory limit
+ *          given by "memory=<MB>" (256 MB by default), search continues
+ *          depth first
+ * parallel depth first search split among threads given by -t option, the
+ *          best cost is shared by all threads; in stream mode the same as
+ *          depth
+ *
+ * Depth first searches can skip nodes which were reached before with the
+ * same number of decided items, the same weight and at least the same
+ * cost. Such nodes are remembered in transposition table of size given by
+ * "table=<MB>" (disabled by default), parallel kernel has table per thread.
+ */
+enum BranchBoundKernel {
+    KERNEL_BREADTH,
+    KERNEL_DEPTH,
+    KERNEL_BEST,
+    KERNEL_PARALLEL
+};
+
+/**
+ * Kernel and its settings parsed from -k option.
+ */
+struct BranchBoundSettings {
+    BranchBoundKernel kernel;
+    LpBound bound;
+    size_t memory;  // memory limit of nodes of best first search in bytes
+    size_t table;   // memory of transposition table in bytes, 0 if disabled
+};
+
+/**
+ * The best solution found so far shared by threads. Cost is read without
+ * locking, so every thread bounds by the best cost immediately; solution
+ * is replaced under lock.
+ */
+class SharedIncumbent {
+    public:
+        SharedIncumbent(const SolutionBits & solution, int cost)
+            : solution(solution), cost(cost) {}
+
+        int Cost() const {
+            return this->cost.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * Replaces the best solution if given one is better.
+         */
+        void Offer(int cost, const SolutionBits & solution) {
+            if (cost <= Cost())
+                return;
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+
+            if (cost > this->cost.load()) {
+                this->solution = solution;
+                this->cost.store(cost);
+            }
+        }
+
+        /**
+         * Solution, all threads have to be finished.
+         */
+        const SolutionBits & Solution() const {
+            return this->solution;
+        }
+
+    private:
+        SolutionBits solution;
+        std::atomic<int> cost;
+        std::mutex mutex;
+};
+
+/**
+ * Node waiting in queue of best first search.
+ */
+struct QueueEntry {
+    long long bound;
+    int slot;  // slot of node in arena
+
+    bool operator<(const QueueEntry & other) const {
+        return this->bound < other.bound;
+    }
+};
+
+/**
+ * Pool of nodes of best first search. Every slot holds node and mask of
+ * its selected items, slots of expanded nodes are reused. All slots given
+ * by memory limit are reserved at once, so vectors never grow over limit.
+ */
+class NodeArena {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param  size    number of items
+         * @param  memory  memory limit of slots in bytes
+         */
+        NodeArena(int size, size_t memory)
+            : words((size + SOLUTION_WORD_BITS - 1) / SOLUTION_WORD_BITS) {
+            // slot holds node, mask, entry of queue and index in released slots
+            size_t slot_bytes = sizeof(SearchNode) + this->words * sizeof(uint64_t) +
+                                sizeof(QueueEntry) + sizeof(int);
+
+            this->capacity = std::max(memory / slot_bytes, (size_t)1);
+
+            // tree of small instance does not have more nodes
+            if (size < 32)
+                this->capacity = std::min(this->capacity, (size_t)2 << size);
+
+            this->nodes.reserve(this->capacity);
+            this->masks.reserve(this->capacity * this->words);
+            this->released.reserve(this->capacity);
+        }
+
+        /**
+         * Stores node into free slot.
+         *
+         * @param   node  stored node
+         * @param   mask  selected items of node
+         * @return        slot of node
+         */
+        int Allocate(const SearchNode & node, const uint64_t * mask) {
+            int slot;
+
+            if (!this->released.empty()) {
+                slot = this->released.back();
+                this->released.pop_back();
+                this->nodes[slot] = node;
+            }
+            else {
+                slot = this->nodes.size();
+                this->nodes.push_back(node);
+                this->masks.resize(this->masks.size() + this->words);
+            }
+
+            std::copy(mask, mask + this->words, Mask(slot));
+
+            return slot;
+        }
+
+        /**
+         * Returns slot for reuse.
+         */
+        void Release(int slot) {
+            this->released.push_back(slot);
+        }
+
+        /**
+         * True if there is no free slot and new one would exceed memory limit.
+         */
+        bool Full() const {
+            return this->released.empty() && this->nodes.size() >= this->capacity;
+        }
+
+        /**
+         * @return  number of slots given by memory limit
+         */
+        size_t Capacity() const {
+            return this->capacity;
+        }
+
+        const SearchNode & Node(int slot) const {
+            return this->nodes[slot];
+        }
+
+        uint64_t * Mask(int slot) {
+            return this->masks.data() + slot * this->words;
+        }
+
+    private:
+        size_t words;     // words of one mask
+        size_t capacity;  // number of reserved slots
+        std::vector<SearchNode> nodes;
+        std::vector<uint64_t> masks;
+        std::vector<int> released;
+};
+
+/**
+ * Node of search tree for instances with at most as many items as bits of
+ * Mask. Selected items are stored in mask, bit i belongs to item i.
+ */
+template <class Mask>
+struct BranchNode {
+    Mask mask;
+    int cost;
+    int weight;
+    int position;  // the last selected item, EMPTY if there is none
+};
 
-void SolveBranchBound(Instances * all_instances);
-std::vector<bool> NextItem(std::vector<bool> * inst_item, int position);
-int GetPosition(std::vector<bool> * inst_item);
-void PrintBinaryVector(std::vector<bool> * bv);
-std::vector<bool> CreateEmptyKnapsack(int size);
-std::vector<bool> Evaluate(Instance * inst, int knapsack_capacity, int max_items);
-int ComputeCurrentCost(std::vector<bool> * distribution, Instance * inst);
-int ComputeRemainingCost(std::vector<bool> * distribution, Instance * inst);
-int ComputeCurrentWeight(std::vector<bool> * distribution, Instance * inst);
+void SolveBranchBound(Instances * all_instances, const BranchBoundSettings & settings, int threads);
+void SolveBranchBoundInstance(const InstanceView & view,
+                              Instance * inst,
+                              const BranchBoundSettings & settings,
+                              TranspositionTable * table);
+TranspositionTable * CreateTable(const BranchBoundSettings & settings);
+BranchBoundSettings ParseSettings(const char * list);
+size_t ParseMegabytes(const std::string & setting, size_t prefix);
+SolutionBits EvaluateDispatch(const InstanceView & view, Instance * inst);
+SolutionBits EvaluateBest(const InstanceView & view,
+                          Instance * inst,
+                          const BranchBoundSettings & settings,
+                          TranspositionTable * table);
+SolutionBits EvaluateParallel(const InstanceView & view,
+                              Instance * inst,
+                              const BranchBoundSettings & settings,
+                              WorkStealingPool * pool,
+                              std::vector<TranspositionTable> * tables);
+void SearchSubtree(const RatioItems & items,
+                   const InstanceView & view,
+                   LpBound bound,
+                   SearchNode node,
+                   SolutionBits current,
+                   SharedIncumbent * best,
+                   std::vector<TranspositionTable> * tables,
+                   int worker,
+                   WorkStealingPool * pool);
+template <class Mask> SolutionBits EvaluateFixed(const InstanceView & view, Instance * inst);
+SolutionBits NextItem(SolutionBits * inst_item, int position);
+int GetPosition(SolutionBits * inst_item);
+void PrintBinaryVector(SolutionBits * bv);
+SolutionBits CreateEmptyKnapsack(int size);
+SolutionBits Evaluate(Instance * inst, int knapsack_capacity, int max_items);
+int ComputeCurrentCost(SolutionBits * distribution, Instance * inst);
+int ComputeRemainingCost(SolutionBits * distribution, Instance * inst);
+int ComputeCurrentWeight(SolutionBits * distribution, Instance * inst);
 
 #endif //BRANCHBOUND_HH
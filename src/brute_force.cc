@@ -13,106 +13,621 @@
 #include "brute_force.h"
 
 int main(int argc, char** argv) {
+    Options options;
     
-    if (argc >= MIN_PARAM) {
-        char * file_name = argv[1];
-        auto inst = new Instances(file_name);
-        SolveBruteForce(inst);
-        inst->PrintSolutions();
+    if (ParseOptions(argc, argv, MIN_PARAM, &options)) {
+        char * file_name = options.params.at(0);
+        BruteForceKernel kernel = ParseKernel(options.kernel);
 
-        delete inst;
+        if (options.stream) {
+            auto solver = [kernel](const InstanceView & view, Instance * inst) {
+                SolveBruteForceInstance(view, inst, kernel);
+            };
+
+            SolveStream(file_name, solver, options.threads, options.binary);
+        }
+        else {
+            auto inst = new Instances(file_name, options.ids);
+            SolveBruteForce(inst, kernel, options.threads);
+            inst->PrintSolutions(options.binary);
+
+            delete inst;
+        }
     }
 
     return EXIT_SUCCESS;
 }
 
 /**
- * Solves knapsack problem using brute force.
+ * Solves knapsack problem using brute force. Small instances are solved
+ * in parallel as whole, subsets of large instances are split among
+ * threads.
  * @todo   add return value for printing solutions
  *
- * @param  inst  all loaded instances
+ * @param  inst     all loaded instances
+ * @param  kernel   algorithm evaluating subsets
+ * @param  threads  number of threads, 0 for all cores
  */
-void SolveBruteForce(Instances * inst) {
-    int capacity = inst->GetCapacity();
-    int volume = inst->GetVolume();
-    int max_items = inst->GetMaxItems();
-    std::vector<Instance *> all_instances =  inst->GetAllInstances();
+void SolveBruteForce(Instances * inst, BruteForceKernel kernel, int threads) {
+    const InstanceBatch & batch = inst->GetBatch();
+    WorkStealingPool pool(threads);
+    Instance * result = NULL;
 
-    std::vector<std::vector<bool>> * combinations = GenerateCombinations(max_items, volume);
-    std::vector<bool> solution;
+    for (size_t i = 0; i < batch.Size(); ++i) {
+        InstanceView view = batch.View(i);
+        result = inst->GetInstance(i);
 
-    for (auto inst_it = all_instances.begin(); inst_it != all_instances.end(); ++inst_it) {
-        solution = Evaluate(*inst_it, combinations, capacity);
-        (*inst_it)->solution = solution;
+        if (view.size >= PARALLEL_MIN_ITEMS && pool.Size() > 1) {
+            result->solution = Evaluate(view, result, kernel, &pool);
+        }
+        else {
+            pool.Submit([view, result, kernel](int) {
+                result->solution = Evaluate(view, result, kernel);
+            });
+        }
     }
 
-    delete combinations;
+    pool.Wait();
 }
 
 /**
- * Generate all possible combinations.
+ * Solves one instance of knapsack problem using brute force.
  *
- * @param len       length of vector
- * @param max_item  maximum number of 1's
- * @return          all_combinations
+ * @param  view    instance of knapsack problem
+ * @param  inst    instance where solution is stored
+ * @param  kernel  algorithm evaluating subsets
  */
-std::vector<std::vector<bool>> * GenerateCombinations(int len, int max_item) {
-    auto combinations = new std::vector<std::vector<bool>>;
+void SolveBruteForceInstance(const InstanceView & view, Instance * inst, BruteForceKernel kernel) {
+    inst->solution = Evaluate(view, inst, kernel);
+}
 
-    for (int i = 1; i <= max_item; ++i) {
-        std::vector<bool> v(len);
-        std::fill(v.begin() + len - i, v.end(), true);
+/**
+ * Translates name of kernel given on command line.
+ *
+ * @param  name  name of kernel, NULL for default one
+ * @return       kernel
+ */
+BruteForceKernel ParseKernel(const char * name) {
+    if (name == NULL || strcmp(name, "gray") == 0)
+        return KERNEL_GRAY;
 
-        do {
-            combinations->push_back(v);
-        } while (std::next_permutation(v.begin(), v.end()));
-    }
+    if (strcmp(name, "mitm") == 0)
+        return KERNEL_MITM;
 
-    return combinations;
+    if (strcmp(name, "lut") == 0)
+        return KERNEL_LUT;
+
+    std::cerr << "Unknown kernel " << name << std::endl;
+    exit(EXIT_FAILURE);
 }
 
+/**
+ * Finds the most valuable subset of items which fits to knapsack and
+ * contains at most volume items.
+ *
+ * @param  view    instance of knapsack problem
+ * @param  inst    instance where sum of costs is stored
+ * @param  kernel  algorithm evaluating subsets
+ * @param  pool    threads among which subsets are split; NULL to evaluate
+ *                 on calling thread
+ * @return         solution; empty if no subset fits to knapsack
+ */
+SolutionBits Evaluate(const InstanceView & view, Instance * inst, BruteForceKernel kernel, WorkStealingPool * pool) {
+    Evaluation best;
 
-std::vector<bool> Evaluate(Instance * inst, std::vector<std::vector<bool>> * comb, int knapsack_capacity) {
-    std::vector<bool> solution;
-    int min_cost = 0;
-    Evaluation ev;
+    // meet in the middle can not limit number of items
+    if (kernel == KERNEL_MITM && view.volume >= view.size) {
+        if (view.size > MAX_MEET_IN_MIDDLE_ITEMS) {
+            std::cerr << "Instance " << view.id << " has too many items for meet in the middle" << std::endl;
+            exit(EXIT_FAILURE);
+        }
 
-    for (auto comb_it = comb->begin() ; comb_it != comb->end(); ++comb_it) {
-        ev = EvaluateCombination(inst, &(*comb_it));
+        best = EvaluateMeetInMiddle(view);
+    }
+    else {
+        if (view.size > MAX_BRUTE_FORCE_ITEMS) {
+            std::cerr << "Instance " << view.id << " has too many items for brute force" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        if (kernel == KERNEL_LUT && view.size > MAX_LUT_ITEMS)
+            kernel = KERNEL_GRAY;
 
-        if (ev.weight <= knapsack_capacity) 
-           if (ev.cost >= min_cost) {
-               solution = *comb_it;
-               min_cost = ev.cost;
-           }
+        if (pool != NULL)
+            best = EvaluateParallel(view, kernel, pool);
+        else if (kernel == KERNEL_LUT)
+            best = EvaluateLookup(view);
+        else
+            best = EvaluateGray(view);
     }
 
     // stores sum of all weight
-    inst->sum_cost = min_cost;
+    inst->sum_cost = best.found ? best.cost : 0;
+
+    if (!best.found)
+        return SolutionBits();
+
+    return MaskToSolution(best.mask, view.size);
+}
+
+/**
+ * Splits subsets of one instance to segments of consecutive masks (Gray
+ * codes or lookup table masks) which are evaluated by pool. Number of
+ * segments is given by number of threads, so queue of pool stays small
+ * for any number of items. Every worker keeps its best subset and they
+ * are reduced when all segments are done.
+ *
+ * @param  view    instance of knapsack problem
+ * @param  kernel  gray or lut
+ * @param  pool    threads evaluating segments
+ * @return         the best feasible subset
+ */
+Evaluation EvaluateParallel(const InstanceView & view, BruteForceKernel kernel, WorkStealingPool * pool) {
+    Evaluation best = {0, 0, 0, 0, false};
+    std::vector<Evaluation> worker_best(pool->Size(), best);
+    uint64_t subsets = (uint64_t)1 << view.size;
+    uint64_t count = (uint64_t)pool->Size() * PARALLEL_SEGMENTS_PER_THREAD;
+    uint64_t segment = std::max(subsets / count + (subsets % count != 0),
+                                (uint64_t)1 << PARALLEL_SEGMENT_BITS);
+    ChunkTable table;
+
+    if (kernel == KERNEL_LUT)
+        BuildChunkTable(view, &table);
+
+    for (uint64_t first = 0; first < subsets; first += segment) {
+        uint64_t last = std::min(first + segment, subsets);
+
+        pool->Submit([&view, &table, &worker_best, kernel, first, last](int worker) {
+            Evaluation ev;
+
+            if (kernel == KERNEL_LUT)
+                ev = EvaluateLookupSegment(view, table, first, last);
+            else
+                ev = EvaluateGraySegment(view, first, last);
+
+            if (ev.found && BetterEvaluation(ev, worker_best[worker], view.size))
+                worker_best[worker] = ev;
+        });
+    }
+
+    pool->Wait();
+
+    for (auto & ev : worker_best)
+        if (ev.found && BetterEvaluation(ev, best, view.size))
+            best = ev;
+
+    return best;
+}
+
+/**
+ * Enumerates all subsets in Gray code order.
+ *
+ * @param  view  instance of knapsack problem
+ * @return       the best feasible subset
+ */
+Evaluation EvaluateGray(const InstanceView & view) {
+    return EvaluateGraySegment(view, 0, (uint64_t)1 << view.size);
+}
+
+/**
+ * Enumerates subsets given by Gray codes of numbers from first to last.
+ * Two consecutive subsets differ in one item, so cost and weight are
+ * updated in constant time and only the current and the best subset are
+ * kept in memory. Subsets with more than volume items are skipped.
+ *
+ * @param  view   instance of knapsack problem
+ * @param  first  the first number
+ * @param  last   number behind the last one
+ * @return        the best feasible subset
+ */
+Evaluation EvaluateGraySegment(const InstanceView & view, uint64_t first, uint64_t last) {
+    Evaluation current = {0, 0, 0, 0, true};
+    Evaluation best = {0, 0, 0, 0, false};
+
+    // the empty subset is skipped, the first subset is evaluated from scratch
+    if (first == 0)
+        first = 1;
+
+    if (first >= last)
+        return best;
+
+    uint64_t code = (first - 1) ^ ((first - 1) >> 1);
+
+    for (int i = 0; i < view.size; ++i) {
+        if ((code >> i) & 1) {
+            current.cost += view.cost[i];
+            current.weight += view.weight[i];
+            current.count++;
+        }
+    }
+
+    current.mask = code;
+
+    for (uint64_t k = first; k < last; ++k) {
+        // item which changes between k-1 and k-th Gray code
+        int item = __builtin_ctzll(k);
+        uint64_t bit = (uint64_t)1 << item;
+
+        if (current.mask & bit) {
+            current.cost -= view.cost[item];
+            current.weight -= view.weight[item];
+            current.count--;
+        }
+        else {
+            current.cost += view.cost[item];
+            current.weight += view.weight[item];
+            current.count++;
+        }
+
+        current.mask ^= bit;
+
+        if (current.count <= view.volume && current.weight <= view.capacity)
+            if (BetterEvaluation(current, best, view.size))
+                best = current;
+    }
+
+    return best;
+}
+
+/**
+ * Horowitz-Sahni meet in the middle. Subsets of both halves of items are
+ * enumerated separately, dominated subsets of the second half are removed
+ * and for every subset of the first half the most valuable fitting subset
+ * of the second half is found by two pointers. Time and memory are
+ * O(2^(n/2)).
+ *
+ * Solution has the optimal cost, but among subsets of equal cost it can
+ * differ from the one found by Gray code enumeration.
+ *
+ * @param  view  instance of knapsack problem
+ * @return       the best feasible subset
+ */
+Evaluation EvaluateMeetInMiddle(const InstanceView & view) {
+    Evaluation best = {0, 0, 0, 0, false};
+    Evaluation current;
+    int half = view.size / 2;
+
+    std::vector<HalfSubset> first = EnumerateHalf(view, 0, half);
+    std::vector<HalfSubset> second = EnumerateHalf(view, half, view.size - half);
+
+    std::sort(first.begin(), first.end(), [](const HalfSubset & a, const HalfSubset & b) {
+        return a.weight < b.weight;
+    });
+    PruneDominated(&second);
+
+    // the heavier subset of the first half, the lighter subset of the second half fits
+    int j = second.size() - 1;
+
+    for (auto & f : first) {
+        while (j >= 0 && f.weight + second[j].weight > view.capacity)
+            --j;
+
+        if (j < 0)
+            break;
+
+        current.cost = f.cost + second[j].cost;
+        current.weight = f.weight + second[j].weight;
+        current.mask = (uint64_t)f.mask | ((uint64_t)second[j].mask << half);
+        current.count = __builtin_popcountll(current.mask);
+        current.found = true;
+
+        // empty subset is not a solution
+        if (current.mask != 0 && BetterEvaluation(current, best, view.size))
+            best = current;
+    }
+
+    return best;
+}
+
+/**
+ * Enumerates all subsets of consecutive items in Gray code order. Subsets
+ * heavier than capacity are left out.
+ *
+ * @param  view   instance of knapsack problem
+ * @param  first  index of the first item of half
+ * @param  count  number of items in half
+ * @return        subsets including the empty one
+ */
+std::vector<HalfSubset> EnumerateHalf(const InstanceView & view, int first, int count) {
+    std::vector<HalfSubset> subsets;
+    HalfSubset current = {0, 0, 0};
+    uint64_t size = (uint64_t)1 << count;
+
+    subsets.reserve(size);
+    subsets.push_back(current);
+
+    for (uint64_t k = 1; k < size; ++k) {
+        int item = __builtin_ctzll(k);
+        uint32_t bit = (uint32_t)1 << item;
+
+        if (current.mask & bit) {
+            current.cost -= view.cost[first + item];
+            current.weight -= view.weight[first + item];
+        }
+        else {
+            current.cost += view.cost[first + item];
+            current.weight += view.weight[first + item];
+        }
 
-    return solution;
+        current.mask ^= bit;
+
+        if (current.weight <= view.capacity)
+            subsets.push_back(current);
+    }
+
+    return subsets;
+}
+
+/**
+ * Sorts subsets by weight and removes every subset which is not more
+ * valuable than some lighter or equally heavy subset. Remaining subsets
+ * are strictly increasing in both weight and cost.
+ *
+ * @param  subsets  subsets of one half of items
+ */
+void PruneDominated(std::vector<HalfSubset> * subsets) {
+    std::sort(subsets->begin(), subsets->end(), [](const HalfSubset & a, const HalfSubset & b) {
+        if (a.weight != b.weight)
+            return a.weight < b.weight;
+
+        return a.cost > b.cost;
+    });
+
+    size_t kept = 0;
+
+    for (size_t i = 0; i < subsets->size(); ++i) {
+        if (kept == 0 || (*subsets)[i].cost > (*subsets)[kept - 1].cost)
+            (*subsets)[kept++] = (*subsets)[i];
+    }
+
+    subsets->resize(kept);
 }
 
-Evaluation EvaluateCombination(Instance * inst, std::vector<bool> * comb) {
-    Evaluation ev;
-    ev.cost = 0;
-    ev.weight = 0;
+/**
+ * Evaluates all subsets with lookup tables. Mask of subset is split to
+ * chunks of 8 items and cost, weight and number of items are sums of table
+ * entries of its chunks. AVX2 kernel is used if processor supports it.
+ *
+ * @param  view  instance of knapsack problem
+ * @return       the best feasible subset
+ */
+Evaluation EvaluateLookup(const InstanceView & view) {
+    ChunkTable table;
+    BuildChunkTable(view, &table);
+
+    return EvaluateLookupSegment(view, table, 0, (uint64_t)1 << view.size);
+}
+
+/**
+ * Evaluates subsets with masks from first to last by lookup tables.
+ *
+ * @param  view   instance of knapsack problem
+ * @param  table  lookup tables of instance
+ * @param  first  the first mask
+ * @param  last   mask behind the last one
+ * @return        the best feasible subset
+ */
+Evaluation EvaluateLookupSegment(const InstanceView & view, const ChunkTable & table, uint64_t first, uint64_t last) {
+#ifdef LUT_AVX2
+    // vector kernel evaluates whole lowest chunks at once
+    if (view.size >= LUT_CHUNK_BITS && first % LUT_CHUNK_SIZE == 0 && last % LUT_CHUNK_SIZE == 0 &&
+        __builtin_cpu_supports("avx2"))
+        return EvaluateLookupAvx2(view, table, first, last);
+#endif
 
-    auto comb_it = comb->begin();
-    auto w_it = inst->weight.begin();
-    for (auto c_it = inst->cost.begin() ; c_it != inst->cost.end(); ++c_it, ++w_it, ++comb_it) {
-        if (*comb_it == true) {
-           ev.cost += *c_it; 
-           ev.weight += *w_it; 
+    return EvaluateLookupScalar(view, table, first, last);
+}
+
+/**
+ * Fills lookup tables of all chunks. Items behind the last item of
+ * instance have zero cost and weight.
+ *
+ * @param  view   instance of knapsack problem
+ * @param  table  filled lookup tables
+ */
+void BuildChunkTable(const InstanceView & view, ChunkTable * table) {
+    for (int c = 0; c < LUT_CHUNKS; ++c) {
+        table->cost[c][0] = 0;
+        table->weight[c][0] = 0;
+
+        // every subset extends the subset without its highest item
+        for (int j = 1; j < LUT_CHUNK_SIZE; ++j) {
+            int high = 31 - __builtin_clz(j);
+            int item = c * LUT_CHUNK_BITS + high;
+            int rest = j ^ (1 << high);
+            bool exists = item < view.size;
+
+            table->cost[c][j] = table->cost[c][rest] + (exists ? view.cost[item] : 0);
+            table->weight[c][j] = table->weight[c][rest] + (exists ? view.weight[item] : 0);
         }
     }
 
-    return ev;
+    for (int j = 0; j < LUT_CHUNK_SIZE; ++j)
+        table->count[j] = __builtin_popcount(j);
+}
+
+/**
+ * Portable lookup table kernel.
+ *
+ * @param  view   instance of knapsack problem
+ * @param  table  lookup tables of instance
+ * @param  first  the first mask
+ * @param  last   mask behind the last one
+ * @return        the best feasible subset
+ */
+Evaluation EvaluateLookupScalar(const InstanceView & view, const ChunkTable & table, uint64_t first, uint64_t last) {
+    Evaluation best = {0, 0, 0, 0, false};
+    Evaluation current;
+
+    current.found = true;
+
+    for (uint64_t mask = std::max(first, (uint64_t)1); mask < last; ++mask) {
+        current.cost = 0;
+        current.weight = 0;
+        current.count = 0;
+
+        for (int c = 0; c < LUT_CHUNKS; ++c) {
+            int j = (mask >> (c * LUT_CHUNK_BITS)) & (LUT_CHUNK_SIZE - 1);
+
+            current.cost += table.cost[c][j];
+            current.weight += table.weight[c][j];
+            current.count += table.count[j];
+        }
+
+        current.mask = mask;
+
+        if (current.count <= view.volume && current.weight <= view.capacity)
+            if (BetterEvaluation(current, best, view.size))
+                best = current;
+    }
+
+    return best;
+}
+
+#ifdef LUT_AVX2
+/**
+ * AVX2 lookup table kernel. Masks sharing higher chunks are evaluated
+ * together, 16 masks per step. Their lowest chunks are consecutive, so
+ * entries are loaded from table directly instead of gathered. Every lane
+ * keeps its most valuable feasible mask and lanes are reduced at the end.
+ *
+ * Solution has the optimal cost, but among subsets of equal cost it can
+ * differ from the one found by Gray code enumeration.
+ *
+ * @param  view   instance of knapsack problem with at least 8 items
+ * @param  table  lookup tables of instance
+ * @param  first  the first mask, multiple of 256
+ * @param  last   mask behind the last one, multiple of 256
+ * @return        the best feasible subset
+ */
+__attribute__((target("avx2")))
+Evaluation EvaluateLookupAvx2(const InstanceView & view, const ChunkTable & table, uint64_t first, uint64_t last) {
+    Evaluation best = {0, 0, 0, 0, false};
+    uint64_t highs = last >> LUT_CHUNK_BITS;
+
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i eight = _mm256_set1_epi32(8);
+    const __m256i capacity = _mm256_set1_epi32(view.capacity);
+    const __m256i volume = _mm256_set1_epi32(view.volume);
+    const __m256i infeasible = _mm256_set1_epi32(-1);
+
+    __m256i best_cost[2] = {infeasible, infeasible};
+    __m256i best_mask[2] = {_mm256_setzero_si256(), _mm256_setzero_si256()};
+
+    for (uint64_t high = first >> LUT_CHUNK_BITS; high < highs; ++high) {
+        int high_cost = 0;
+        int high_weight = 0;
+        int high_count = 0;
+
+        for (int c = 1; c < LUT_CHUNKS; ++c) {
+            int j = (high >> ((c - 1) * LUT_CHUNK_BITS)) & (LUT_CHUNK_SIZE - 1);
+
+            high_cost += table.cost[c][j];
+            high_weight += table.weight[c][j];
+            high_count += table.count[j];
+        }
+
+        __m256i hc = _mm256_set1_epi32(high_cost);
+        __m256i hw = _mm256_set1_epi32(high_weight);
+        __m256i hn = _mm256_set1_epi32(high_count);
+        __m256i mask = _mm256_add_epi32(_mm256_set1_epi32(high << LUT_CHUNK_BITS), lanes);
+
+        for (int low = 0; low < LUT_CHUNK_SIZE; low += 16) {
+            for (int k = 0; k < 2; ++k) {
+                int j = low + 8 * k;
+                __m256i cost = _mm256_add_epi32(hc, _mm256_loadu_si256((const __m256i *)&table.cost[0][j]));
+                __m256i weight = _mm256_add_epi32(hw, _mm256_loadu_si256((const __m256i *)&table.weight[0][j]));
+                __m256i count = _mm256_add_epi32(hn, _mm256_loadu_si256((const __m256i *)&table.count[j]));
+
+                // lanes over capacity or volume get cost -1
+                __m256i over = _mm256_or_si256(_mm256_cmpgt_epi32(weight, capacity),
+                                               _mm256_cmpgt_epi32(count, volume));
+                cost = _mm256_blendv_epi8(cost, infeasible, over);
+
+                __m256i better = _mm256_cmpgt_epi32(cost, best_cost[k]);
+                best_cost[k] = _mm256_blendv_epi8(best_cost[k], cost, better);
+                best_mask[k] = _mm256_blendv_epi8(best_mask[k], mask, better);
+
+                mask = _mm256_add_epi32(mask, eight);
+            }
+        }
+    }
+
+    // reduction of lanes
+    int costs[16];
+    uint32_t masks[16];
+    Evaluation current;
+
+    _mm256_storeu_si256((__m256i *)costs, best_cost[0]);
+    _mm256_storeu_si256((__m256i *)(costs + 8), best_cost[1]);
+    _mm256_storeu_si256((__m256i *)masks, best_mask[0]);
+    _mm256_storeu_si256((__m256i *)(masks + 8), best_mask[1]);
+
+    for (int i = 0; i < 16; ++i) {
+        // empty subset is not a solution
+        if (costs[i] < 0 || masks[i] == 0)
+            continue;
+
+        current.cost = costs[i];
+        current.mask = masks[i];
+        current.count = __builtin_popcount(masks[i]);
+        current.weight = 0;
+        current.found = true;
+
+        for (int c = 0; c < LUT_CHUNKS; ++c)
+            current.weight += table.weight[c][(masks[i] >> (c * LUT_CHUNK_BITS)) & (LUT_CHUNK_SIZE - 1)];
+
+        if (BetterEvaluation(current, best, view.size))
+            best = current;
+    }
+
+    return best;
+}
+#endif
+
+/**
+ * Decides if candidate subset replaces the best one. Among subsets of the
+ * same cost the one with more items wins and then the one with items
+ * closer to the beginning, therefore results do not depend on order of
+ * enumeration.
+ *
+ * @param  candidate  evaluated subset
+ * @param  best       the best subset so far
+ * @param  size       number of items
+ * @return            true if candidate is better
+ */
+bool BetterEvaluation(const Evaluation & candidate, const Evaluation & best, int size) {
+    if (!best.found || candidate.cost != best.cost)
+        return !best.found || candidate.cost > best.cost;
+
+    if (candidate.count != best.count)
+        return candidate.count > best.count;
+
+    // the first item is the most significant one
+    for (int i = 0; i < size; ++i) {
+        uint64_t bit = (uint64_t)1 << i;
+
+        if ((candidate.mask & bit) != (best.mask & bit))
+            return (candidate.mask & bit) != 0;
+    }
+
+    return false;
+}
+
+/**
+ * Converts mask of subset to binary solution.
+ *
+ * @param  mask  bit i belongs to item i
+ * @param  size  number of items
+ * @return       binary solution
+ */
+SolutionBits MaskToSolution(uint64_t mask, int size) {
+    return SolutionBits::FromMask(mask, size);
 }
 
-void PrintVector(std::vector<bool> * vec) {
-    for (std::vector<bool>::iterator it=vec->begin(); it!=vec->end(); ++it)
-        std::cout << *it << " ";
+void PrintVector(SolutionBits * vec) {
+    for (size_t i = 0; i < vec->Size(); ++i)
+        std::cout << vec->Get(i) << " ";
 
     std::cout << std::endl;
 }
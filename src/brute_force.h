@@ -7,23 +7,100 @@
 #ifndef BRUTEFORCE_HH
 #define BRUTEFORCE_HH
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LUT_AVX2
+#include <immintrin.h>
+#endif
+
 #include "instances.h"
+#include "options.h"
+#include "pipeline.h"
+#include "work_stealing.h"
 
 #define MIN_PARAM 2
+#define MAX_BRUTE_FORCE_ITEMS 63
+#define MAX_MEET_IN_MIDDLE_ITEMS 60
+#define MAX_LUT_ITEMS 32
+#define LUT_CHUNK_BITS 8
+#define LUT_CHUNK_SIZE (1 << LUT_CHUNK_BITS)
+#define LUT_CHUNKS (MAX_LUT_ITEMS / LUT_CHUNK_BITS)
+#define PARALLEL_MIN_ITEMS 20
+#define PARALLEL_SEGMENT_BITS 16
+#define PARALLEL_SEGMENTS_PER_THREAD 64
 
+/**
+ * Algorithms evaluating subsets of one instance, selected by -k option.
+ *
+ * gray  all subsets in Gray code order (default)
+ * mitm  meet in the middle; both halves of items are enumerated separately
+ *       and merged, used only if volume does not limit number of items
+ * lut   subsets as integer masks evaluated by lookup tables of 8 items,
+ *       AVX2 if processor supports it; used only for at most 32 items
+ */
+enum BruteForceKernel {
+    KERNEL_GRAY,
+    KERNEL_MITM,
+    KERNEL_LUT
+};
+
+/**
+ * Best subset found during enumeration. Subsets are represented by masks,
+ * bit i belongs to item i.
+ */
 struct Evaluation {
     int cost;
     int weight;
+    int count;      // number of items in subset
+    uint64_t mask;
+    bool found;     // false if no feasible subset was evaluated
+};
+
+/**
+ * Subset of one half of items used by meet in the middle.
+ */
+struct HalfSubset {
+    int weight;
+    int cost;
+    uint32_t mask;  // bit i belongs to the i-th item of half
+};
+
+/**
+ * Sums of costs, weights and numbers of items of all subsets of every
+ * chunk of 8 consecutive items. Subset of whole instance is evaluated by
+ * adding one entry of each chunk.
+ */
+struct ChunkTable {
+    int cost[LUT_CHUNKS][LUT_CHUNK_SIZE];
+    int weight[LUT_CHUNKS][LUT_CHUNK_SIZE];
+    int count[LUT_CHUNK_SIZE];  // the same for all chunks
 };
 
-void SolveBruteForce(Instances * inst);
-std::vector<std::vector<bool>> * GenerateCombinations(int, int);
-std::vector<bool> Evaluate(Instance *, std::vector<std::vector<bool>> *, int);
-Evaluation EvaluateCombination(Instance *, std::vector<bool> *);
-void PrintVector(std::vector<bool> *);
+void SolveBruteForce(Instances * inst, BruteForceKernel kernel, int threads);
+void SolveBruteForceInstance(const InstanceView &, Instance *, BruteForceKernel kernel);
+BruteForceKernel ParseKernel(const char *);
+SolutionBits Evaluate(const InstanceView &, Instance *, BruteForceKernel kernel, WorkStealingPool * pool = NULL);
+Evaluation EvaluateParallel(const InstanceView &, BruteForceKernel kernel, WorkStealingPool * pool);
+Evaluation EvaluateGray(const InstanceView &);
+Evaluation EvaluateGraySegment(const InstanceView &, uint64_t first, uint64_t last);
+Evaluation EvaluateMeetInMiddle(const InstanceView &);
+std::vector<HalfSubset> EnumerateHalf(const InstanceView &, int first, int count);
+void PruneDominated(std::vector<HalfSubset> *);
+Evaluation EvaluateLookup(const InstanceView &);
+Evaluation EvaluateLookupSegment(const InstanceView &, const ChunkTable &, uint64_t first, uint64_t last);
+void BuildChunkTable(const InstanceView &, ChunkTable *);
+Evaluation EvaluateLookupScalar(const InstanceView &, const ChunkTable &, uint64_t first, uint64_t last);
+#ifdef LUT_AVX2
+Evaluation EvaluateLookupAvx2(const InstanceView &, const ChunkTable &, uint64_t first, uint64_t last);
+#endif
+bool BetterEvaluation(const Evaluation &, const Evaluation &, int);
+SolutionBits MaskToSolution(uint64_t, int);
+void PrintVector(SolutionBits *);
 //void StoreSolution();
 
 
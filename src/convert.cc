@@ -0,0 +1,49 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ *
+ * @section DESCRIPTION
+ *
+ * KNAPSACK PROBLEM 
+ *
+ * Converts text instance file (*.inst.dat) to binary columnar format, which
+ * can be loaded by all solvers without parsing.
+ */
+
+#include "convert.h"
+
+int main(int argc, char** argv) {
+
+    if (argc < MIN_PARAM) {
+        std::cerr << "Usage: " << argv[0] << " <input.inst.dat> <output>" << std::endl;
+        return CONVERT_FAILED;
+    }
+
+    char * input_file_name = argv[1];
+    char * output_file_name = argv[2];
+
+    if (!Instances::ExistFile(input_file_name)) {
+        std::cerr << "Given file does not exist!" << std::endl;
+        return CONVERT_FAILED;
+    }
+
+    auto inst = new Instances(input_file_name);
+
+    // empty binary file would be indistinguishable from converted empty input
+    if (inst->GetBatch().Size() == 0) {
+        std::cerr << "Given file does not contain any instance!" << std::endl;
+        delete inst;
+        return CONVERT_FAILED;
+    }
+
+    if (!inst->WriteBinary(output_file_name)) {
+        std::cerr << "Binary file could not be written!" << std::endl;
+        delete inst;
+        return CONVERT_FAILED;
+    }
+
+    delete inst;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,15 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ */
+
+#ifndef CONVERT_HH
+#define CONVERT_HH
+
+#include "instances.h"
+
+#define MIN_PARAM        3
+#define CONVERT_FAILED   1
+
+#endif //CONVERT_HH
@@ -0,0 +1,200 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ *
+ * @section DESCRIPTION
+ *
+ * KNAPSACK PROBLEM 
+ *
+ * Depth first search of include/exclude tree of items sorted by ratio of
+ * cost/weight, shared by branch and bound and by dynamic programming for
+ * instances which do not fit into its tables.
+ */
+
+#include "depth_search.h"
+
+/**
+ * Depth first search of include/exclude tree of items sorted by ratio.
+ *
+ * @param  view   instance of knapsack problem
+ * @param  inst   instance where sum of costs is stored
+ * @param  bound  upper bound of cost of nodes
+ * @param  table  transposition table cleared before search, NULL if disabled
+ * @return        solution of instance
+ */
+SolutionBits SearchDepth(const InstanceView & view, Instance * inst, LpBound bound, TranspositionTable * table) {
+    RatioItems items = SortByRatio(view);
+
+    if (table != NULL)
+        table->Clear();
+
+    Incumbent best = {SolutionBits(view.size), 0};
+    best.cost = GreedySolution(items, view, &best.solution);
+
+    SolutionBits current(view.size);
+    SearchNode root = {0, 0, 0, 0, 0};
+
+    DiveDepth(items, view, bound, root, &current, &best, table);
+
+    // stores sum cost of all used items
+    inst->sum_cost = best.cost;
+
+    return RestoreOrder(items, best.solution);
+}
+
+/**
+ * Maps solution of sorted items back to order of instance.
+ *
+ * @param   items   items sorted by ratio
+ * @param   sorted  selected sorted items
+ * @return          solution of instance
+ */
+SolutionBits RestoreOrder(const RatioItems & items, const SolutionBits & sorted) {
+    SolutionBits solution(sorted.Size());
+
+    for (size_t i = 0; i < sorted.Size(); ++i)
+        solution.Set(items.order[i], sorted.Get(i));
+
+    return solution;
+}
+
+/**
+ * Finds initial solution for bounding. Items are added greedily by ratio
+ * and the most valuable single item is taken instead if it is better.
+ *
+ * @param   items     items sorted by ratio
+ * @param   view      instance of knapsack problem
+ * @param   solution  selected sorted items
+ * @return            cost of solution
+ */
+int GreedySolution(const RatioItems & items, const InstanceView & view, SolutionBits * solution) {
+    int size = items.cost.size();
+    int cost = 0;
+    int weight = 0;
+    int count = 0;
+    int single = EMPTY;
+
+    for (int i = 0; i < size; ++i) {
+        if (items.weight[i] > view.capacity)
+            continue;
+
+        if (single == EMPTY || items.cost[i] > items.cost[single])
+            single = i;
+
+        if (weight + items.weight[i] <= view.capacity && count < view.volume) {
+            solution->Set(i, true);
+            cost += items.cost[i];
+            weight += items.weight[i];
+            ++count;
+        }
+    }
+
+    if (single != EMPTY && view.volume > 0 && items.cost[single] > cost) {
+        *solution = SolutionBits(size);
+        solution->Set(single, true);
+        cost = items.cost[single];
+    }
+
+    return cost;
+}
+
+/**
+ * Sorts items by decreasing ratio of cost/weight and computes prefix sums
+ * of sorted costs and weights.
+ *
+ * @param   view  instance of knapsack problem
+ * @return        sorted items
+ */
+RatioItems SortByRatio(const InstanceView & view) {
+    RatioItems items;
+    int size = view.size;
+
+    // ratios are compared by cross multiplication, items without weight go first
+    auto higher_ratio = [&view](int a, int b) {
+        if (view.weight[a] == 0 || view.weight[b] == 0)
+            return view.weight[a] == 0 && view.weight[b] != 0;
+
+        return (long long)view.cost[a] * view.weight[b] > (long long)view.cost[b] * view.weight[a];
+    };
+
+    items.order.resize(size);
+    std::iota(items.order.begin(), items.order.end(), 0);
+    std::stable_sort(items.order.begin(), items.order.end(), higher_ratio);
+
+    items.cost.resize(size);
+    items.weight.resize(size);
+    items.prefix_cost.assign(size + 1, 0);
+    items.prefix_weight.assign(size + 1, 0);
+
+    for (int i = 0; i < size; ++i) {
+        items.cost[i] = view.cost[items.order[i]];
+        items.weight[i] = view.weight[items.order[i]];
+        items.prefix_cost[i + 1] = items.prefix_cost[i] + items.cost[i];
+        items.prefix_weight[i + 1] = items.prefix_weight[i] + items.weight[i];
+    }
+
+    return items;
+}
+
+/**
+ * Computes upper bound of cost which can be added by items from given
+ * depth on. Break item, the first one which does not fit, is found by
+ * binary search in prefix sums of weights.
+ *
+ * @param   items     items sorted by ratio
+ * @param   depth     the first item which can be added
+ * @param   capacity  remaining capacity of knapsack
+ * @param   bound     type of bound
+ * @return            upper bound of added cost
+ */
+long long UpperBound(const RatioItems & items, int depth, int capacity, LpBound bound) {
+    int size = items.cost.size();
+    long long limit = items.prefix_weight[depth] + capacity;
+
+    // the last prefix which fits, it is at least empty prefix of depth
+    int b = std::upper_bound(items.prefix_weight.begin() + depth,
+                             items.prefix_weight.end(),
+                             limit) - items.prefix_weight.begin() - 1;
+
+    long long cost = items.prefix_cost[b] - items.prefix_cost[depth];
+
+    // all items fit
+    if (b == size)
+        return cost;
+
+    // break item has nonzero weight, free capacity is lower than it
+    long long free = limit - items.prefix_weight[b];
+
+    if (bound == BOUND_DANTZIG)
+        return cost + free * items.cost[b] / items.weight[b];
+
+    // break item is excluded, free capacity is filled by the next item
+    long long exclude = cost;
+
+    if (b + 1 < size)
+        exclude += free * items.cost[b + 1] / items.weight[b + 1];
+
+    // break item is forced in, the previous item is removed fractionally
+    long long include = exclude;
+
+    if (b > depth && items.weight[b - 1] > 0) {
+        long long missing = items.weight[b] - free;
+
+        include = cost + FloorDivide((long long)items.cost[b] * items.weight[b - 1] - missing * items.cost[b - 1],
+                                     items.weight[b - 1]);
+    }
+
+    return std::max(exclude, include);
+}
+
+/**
+ * Integer division rounding towards negative infinity.
+ *
+ * @param   a  dividend
+ * @param   b  positive divisor
+ * @return     floor of a/b
+ */
+long long FloorDivide(long long a, long long b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
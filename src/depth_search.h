@@ -0,0 +1,280 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ */
+
+#ifndef DEPTH_SEARCH_HH
+#define DEPTH_SEARCH_HH
+
+#define EMPTY      -1
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <stdint.h>
+
+#include "instances.h"
+
+/**
+ * Upper bounds of cost of nodes searched by depth kernel.
+ *
+ * dantzig  LP relaxation; items are added by ratio and the first item
+ *          which does not fit is added fractionally (default)
+ * u2       Martello-Toth bound; the better of LP relaxations where the
+ *          first item which does not fit is excluded or forced in
+ */
+enum LpBound {
+    BOUND_DANTZIG,
+    BOUND_MARTELLO_TOTH
+};
+
+/**
+ * Items sorted by decreasing ratio of cost/weight with prefix sums of
+ * their costs and weights. Item i of instance is order[i]; prefix sums
+ * hold sums of the first i items, so they have one more element.
+ */
+struct RatioItems {
+    std::vector<int> order;
+    std::vector<int> cost;
+    std::vector<int> weight;
+    std::vector<long long> prefix_cost;
+    std::vector<long long> prefix_weight;
+};
+
+/**
+ * Branch of include/exclude tree which is searched next in given depth.
+ */
+enum NodeBranch {
+    BRANCH_INCLUDE,
+    BRANCH_EXCLUDE,
+    BRANCH_DONE
+};
+
+/**
+ * Node of include/exclude tree of items sorted by ratio, items before
+ * depth are decided.
+ */
+struct SearchNode {
+    long long bound;  // upper bound of cost of subtree
+    int cost;
+    int weight;
+    int count;        // number of selected items
+    int depth;
+};
+
+/**
+ * The best solution found so far, selected items are sorted by ratio.
+ */
+struct Incumbent {
+    SolutionBits solution;
+    int cost;
+
+    int Cost() const {
+        return this->cost;
+    }
+
+    /**
+     * Replaces the best solution if given one is better.
+     */
+    void Offer(int cost, const SolutionBits & solution) {
+        if (cost > this->cost) {
+            this->cost = cost;
+            this->solution = solution;
+        }
+    }
+};
+
+/**
+ * Bounded hash table of the highest costs of visited nodes of depth first
+ * search. Node is identified by depth, weight and number of selected items;
+ * subtrees of nodes with the same identification are the same, so the one
+ * with lower cost does not have to be searched. Bucket holds two entries,
+ * the first one keeps the shallowest node, whose subtree is the largest,
+ * the second one is always replaced. Table is allocated once and reused
+ * for all instances, entries of previous instances are recognized by their
+ * generation.
+ */
+class TranspositionTable {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param  memory  memory of table in bytes, rounded down to power of two buckets
+         */
+        TranspositionTable(size_t memory) : generation(1) {
+            size_t buckets = 1;
+
+            while (buckets * 2 * sizeof(Bucket) <= memory)
+                buckets *= 2;
+
+            this->buckets.assign(buckets, Bucket());
+        }
+
+        /**
+         * Invalidates all entries before search of next instance.
+         */
+        void Clear() {
+            // entries of old generations are reset only when counter wraps
+            if (++this->generation == 0) {
+                this->buckets.assign(this->buckets.size(), Bucket());
+                this->generation = 1;
+            }
+        }
+
+        /**
+         * Checks if node was visited with at least the same cost, otherwise
+         * node is stored.
+         *
+         * @param   depth   number of decided items
+         * @param   weight  weight of selected items
+         * @param   count   number of selected items, 0 if it is not limited
+         * @param   cost    cost of selected items
+         * @return          true if node does not have to be searched
+         */
+        bool Dominated(int depth, int weight, int count, int cost) {
+            uint64_t hash = ((uint64_t)depth * 0x9e3779b97f4a7c15ULL)
+                          ^ ((uint64_t)(uint32_t)weight * 0xc2b2ae3d27d4eb4fULL)
+                          ^ ((uint64_t)count * 0x165667b19e3779f9ULL);
+            hash ^= hash >> 29;
+
+            Bucket & bucket = this->buckets[hash & (this->buckets.size() - 1)];
+
+            for (auto & entry : bucket.entries) {
+                if (entry.generation == this->generation && entry.depth == depth &&
+                    entry.weight == weight && entry.count == count) {
+                    if (entry.cost >= cost)
+                        return true;
+
+                    entry.cost = cost;
+                    return false;
+                }
+            }
+
+            Entry entry = {depth, weight, count, cost, this->generation};
+
+            // shallower node moves the kept one to always replaced entry
+            if (bucket.entries[0].generation != this->generation || depth <= bucket.entries[0].depth) {
+                bucket.entries[1] = bucket.entries[0];
+                bucket.entries[0] = entry;
+            }
+            else
+                bucket.entries[1] = entry;
+
+            return false;
+        }
+
+    private:
+        struct Entry {
+            int depth;
+            int weight;
+            int count;
+            int cost;
+            uint32_t generation;  // entry is valid only in generation of table
+        };
+
+        struct Bucket {
+            Entry entries[2];
+        };
+
+        std::vector<Bucket> buckets;
+        uint32_t generation;
+};
+
+SolutionBits SearchDepth(const InstanceView & view, Instance * inst, LpBound bound, TranspositionTable * table);
+SolutionBits RestoreOrder(const RatioItems & items, const SolutionBits & sorted);
+RatioItems SortByRatio(const InstanceView & view);
+int GreedySolution(const RatioItems & items, const InstanceView & view, SolutionBits * solution);
+long long UpperBound(const RatioItems & items, int depth, int capacity, LpBound bound);
+long long FloorDivide(long long a, long long b);
+
+/**
+ * Depth first search of subtree of given node, item i is decided in depth
+ * i and branch including it is searched first. Cost, weight and number of
+ * selected items of current node are updated when search descends and
+ * restored when it returns, so only one branch state per depth is stored.
+ * Number of selected items is limited by volume.
+ *
+ * @param  items    items sorted by ratio
+ * @param  view     instance of knapsack problem
+ * @param  bound    upper bound of cost of nodes
+ * @param  node     root of searched subtree
+ * @param  current  selected items of node, restored at the end
+ * @param  best     the best solution found so far, Incumbent or SharedIncumbent
+ * @param  table    transposition table, NULL if disabled
+ */
+template <class Best>
+void DiveDepth(const RatioItems & items,
+               const InstanceView & view,
+               LpBound bound,
+               const SearchNode & node,
+               SolutionBits * current,
+               Best * best,
+               TranspositionTable * table = NULL) {
+
+    int size = view.size;
+
+    // number of selected items identifies node only if it is limited
+    bool limited = view.volume < size;
+    std::vector<NodeBranch> branch(size + 1);
+
+    // state of current node
+    int cost = node.cost;
+    int weight = node.weight;
+    int count = node.count;
+    int depth = node.depth;
+
+    branch[depth] = BRANCH_INCLUDE;
+
+    while (depth >= node.depth) {
+        switch (branch[depth]) {
+            case BRANCH_INCLUDE:
+                best->Offer(cost, *current);
+
+                // COST bounding, leaves are bounded as well
+                if (cost + UpperBound(items, depth, view.capacity - weight, bound) <= best->Cost()) {
+                    --depth;
+                    break;
+                }
+
+                // the same subtree was searched from node with at least the same
+                // cost; root may be stored already by best first search
+                if (table != NULL && depth > node.depth && table->Dominated(depth, weight, limited ? count : 0, cost)) {
+                    --depth;
+                    break;
+                }
+
+                branch[depth] = BRANCH_EXCLUDE;
+
+                // WEIGHT bounding
+                if (weight + items.weight[depth] <= view.capacity && count < view.volume) {
+                    current->Set(depth, true);
+                    cost += items.cost[depth];
+                    weight += items.weight[depth];
+                    ++count;
+
+                    branch[++depth] = BRANCH_INCLUDE;
+                }
+                break;
+
+            case BRANCH_EXCLUDE:
+                if (current->Get(depth)) {
+                    current->Set(depth, false);
+                    cost -= items.cost[depth];
+                    weight -= items.weight[depth];
+                    --count;
+                }
+
+                branch[depth] = BRANCH_DONE;
+                branch[++depth] = BRANCH_INCLUDE;
+                break;
+
+            case BRANCH_DONE:
+                --depth;
+                break;
+        }
+    }
+}
+
+#endif //DEPTH_SEARCH_HH
@@ -13,14 +13,21 @@
 #include "dynamic.h"
 
 int main(int argc, char** argv) {
+    Options options;
     
-    if (argc >= MIN_PARAM) {
-        char * file_name = argv[1];
-        auto inst = new Instances(file_name);
-        SolveDynamic(inst);
-        inst->PrintSolutions();
+    if (ParseOptions(argc, argv, MIN_PARAM, &options)) {
+        char * file_name = options.params.at(0);
 
-        delete inst;
+        if (options.stream) {
+            SolveStream(file_name, SolveDynamicInstance, options.threads, options.binary);
+        }
+        else {
+            auto inst = new Instances(file_name, options.ids);
+            SolveDynamic(inst);
+            inst->PrintSolutions(options.binary);
+
+            delete inst;
+        }
     }
 
     return EXIT_SUCCESS;
@@ -32,17 +39,29 @@ int main(int argc, char** argv) {
  * @param  inst  different instances of knapsack problem
  */
 void SolveDynamic(Instances * inst) {
-    int capacity = inst->GetCapacity();
-    int volume = inst->GetVolume();
-    int max_items = inst->GetMaxItems();
+    const InstanceBatch & batch = inst->GetBatch();
+    const std::vector<Instance *> & all_instances = inst->GetAllInstances();
 
-    std::vector<Instance *> all_instances =  inst->GetAllInstances();
-    std::vector<bool> solution;
+    for (size_t i = 0; i < batch.Size(); ++i)
+        SolveDynamicInstance(batch.View(i), all_instances.at(i));
+}
 
-    for (auto inst_it = all_instances.begin(); inst_it != all_instances.end(); ++inst_it) {
-        solution = Evaluate(*inst_it, capacity, max_items);
-        (*inst_it)->solution = solution;
-    }
+/**
+ * Solves one instance of knapsack problem by dynamic programming method.
+ * Instances with limited number of items are solved by cardinality
+ * constrained dynamic programming, instances where cost of every item
+ * equals its weight are solved as subset sum problem.
+ *
+ * @param  view  instance of knapsack problem
+ * @param  inst  instance where solution is stored
+ */
+void SolveDynamicInstance(const InstanceView & view, Instance * inst) {
+    if (view.volume < view.size)
+        SolveCardinalityInstance(view, inst);
+    else if (IsSubsetSum(view))
+        SolveSubsetSumInstance(view, inst);
+    else
+        inst->solution = Evaluate(inst, view.capacity, view.size);
 }
 
 /**
@@ -54,8 +73,7 @@ void SolveDynamic(Instances * inst) {
  * @param  max_items  maximum number of items in knapsack
  * @return            binary vector, the best selection of items for knapsack
  */
-std::vector<bool> Evaluate(Instance * inst, int capacity, int max_items) {
-    std::vector<bool> solution;
+SolutionBits Evaluate(Instance * inst, int capacity, int max_items) {
     std::vector<int> weights = inst->weight;
 
     // create network
@@ -109,9 +127,9 @@ Cell * ExistCell(std::vector<Cell *> * column, int weight) {
  *
  * @param  bv  binary vector
  */
-void PrintBinaryVector(std::vector<bool> * bv) {
-    for (auto it = bv->begin(); it != bv->end(); ++it)
-        std::cout << *it;
+void PrintBinaryVector(SolutionBits * bv) {
+    for (size_t i = 0; i < bv->Size(); ++i)
+        std::cout << bv->Get(i);
 
     std::cout << std::endl;
 }
@@ -192,7 +210,6 @@ Solution SolveNetwork(Instance * inst, std::vector<std::vector<Cell *>> * table)
 
     // solution temporary variables
     Solution S;
-    std::vector<bool> solution_vector;
     Cell * solution_cell = NULL;
 
     // solves network
@@ -245,32 +262,264 @@ Solution SolveNetwork(Instance * inst, std::vector<std::vector<Cell *>> * table)
  * @param   cell  cell contataining final solution
  * @return        final combination of items in knapsack
  */
-std::vector<bool> FindPath(Cell * cell) {
-    std::vector<bool> path;
+SolutionBits FindPath(Cell * cell) {
+    SolutionBits path;
     Cell * tmp_cell = cell;
 
     while (tmp_cell != NULL) {
         switch (tmp_cell->direction) {
             // left
             case 0:
-                path.push_back(0);
+                path.PushBack(0);
                 tmp_cell = tmp_cell->forward_first;
                 break;
 
             // bottom left
             case 1:
-                path.push_back(1);
+                path.PushBack(1);
                 tmp_cell = tmp_cell->forward_second;
                 break;
         }
     }
 
     // delete last item, exceeds limits of knapsack
-    path.erase(path.end());
+    if (!path.Empty())
+        path.PopBack();
 
     return path;
 }
 
+/**
+ * Checks if cost of every item equals its weight.
+ *
+ * @param   view  instance of knapsack problem
+ * @return        true if instance is subset sum problem
+ */
+bool IsSubsetSum(const InstanceView & view) {
+    for (int i = 0; i < view.size; ++i)
+        if (view.cost[i] != view.weight[i]) return false;
+
+    return view.size > 0;
+}
+
+/**
+ * Solves subset sum problem. Reachable sums are stored in bitset and every
+ * item adds its weight to all of them by one shift-or, 64 sums per word
+ * operation. Bitsets are kept only at checkpoints every sqrt(n) items;
+ * during recovery of solution the bitsets between two checkpoints are
+ * computed again and items are chosen backward.
+ *
+ * @param  view  instance of knapsack problem
+ * @param  inst  instance where solution is stored
+ */
+void SolveSubsetSumInstance(const InstanceView & view, Instance * inst) {
+    long long total = 0;
+
+    for (int i = 0; i < view.size; ++i)
+        total += view.weight[i];
+
+    // sums above weight of all items are not reachable
+    int limit = std::max(0, (int)std::min<long long>(view.capacity, total));
+    int words = limit / WORD_BITS + 1;
+    int block = std::max(1, (int)std::ceil(std::sqrt(view.size)));
+
+    std::vector<uint64_t> bits(words, 0);
+    std::vector<std::vector<uint64_t>> checkpoints;
+
+    bits[0] = 1;
+
+    for (int i = 0; i < view.size; ++i) {
+        if (i % block == 0)
+            checkpoints.push_back(bits);
+
+        ShiftOr(&bits, view.weight[i], limit);
+    }
+
+    int target = HighestBit(bits);
+    SolutionBits solution (view.size);
+    std::vector<std::vector<uint64_t>> states;
+
+    inst->sum_cost = target;
+
+    for (int b = checkpoints.size() - 1; b >= 0; --b) {
+        int first = b * block;
+        int last = std::min(view.size, first + block);
+
+        // states[j] are sums reachable by items in front of item first + j
+        states.assign(1, checkpoints[b]);
+
+        for (int i = first; i < last - 1; ++i) {
+            states.push_back(states.back());
+            ShiftOr(&states.back(), view.weight[i], limit);
+        }
+
+        for (int i = last - 1; i >= first; --i) {
+            if (!TestBit(states[i - first], target)) {
+                solution.Set(i, 1);
+                target -= view.weight[i];
+            }
+        }
+
+        checkpoints.pop_back();
+    }
+
+    inst->solution = solution;
+}
+
+/**
+ * Adds shift to all sums stored in bitset. Sums above limit are dropped.
+ *
+ * @param  bits   bitset of reachable sums
+ * @param  shift  added value
+ * @param  limit  the highest stored sum
+ */
+void ShiftOr(std::vector<uint64_t> * bits, int shift, int limit) {
+    if (shift <= 0 || shift > limit)
+        return;
+
+    int words = bits->size();
+    int word_shift = shift / WORD_BITS;
+    int bit_shift = shift % WORD_BITS;
+    uint64_t * b = bits->data();
+
+    // from the highest word, so sources are not overwritten yet
+    for (int j = words - 1; j >= word_shift; --j) {
+        uint64_t value = b[j - word_shift] << bit_shift;
+
+        if (bit_shift != 0 && j - word_shift - 1 >= 0)
+            value |= b[j - word_shift - 1] >> (WORD_BITS - bit_shift);
+
+        b[j] |= value;
+    }
+
+    // clear sums above limit
+    int used = limit % WORD_BITS + 1;
+
+    if (used < WORD_BITS)
+        b[words - 1] &= ((uint64_t)1 << used) - 1;
+}
+
+/**
+ * Checks if sum is stored in bitset.
+ */
+bool TestBit(const std::vector<uint64_t> & bits, int index) {
+    return (bits[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+}
+
+/**
+ * Finds the highest sum stored in bitset.
+ */
+int HighestBit(const std::vector<uint64_t> & bits) {
+    for (int j = bits.size() - 1; j >= 0; --j)
+        if (bits[j] != 0)
+            return j * WORD_BITS + (WORD_BITS - 1 - __builtin_clzll(bits[j]));
+
+    return 0;
+}
+
+/**
+ * Solves knapsack problem where at most volume items can be selected.
+ * Table indexed by number of items and capacity stores the highest cost
+ * of at most k items with weight at most c and it is updated in place by
+ * every item. Like in subset sum, tables are kept only at checkpoints
+ * every sqrt(n) items and solution is recovered backward block by block.
+ * Instances whose tables exceed memory limit are solved by depth first
+ * branch and bound, which needs memory linear in number of items.
+ *
+ * @param  view  instance of knapsack problem
+ * @param  inst  instance where solution is stored
+ */
+void SolveCardinalityInstance(const InstanceView & view, Instance * inst) {
+    long long total = 0;
+
+    for (int i = 0; i < view.size; ++i)
+        total += view.weight[i];
+
+    int items = std::max(0, std::min(view.volume, view.size));
+    int capacity = std::max(0, (int)std::min<long long>(view.capacity, total));
+    int block = std::max(1, (int)std::ceil(std::sqrt(view.size)));
+    size_t table_size = (size_t)(items + 1) * (capacity + 1);
+    size_t tables = (view.size + block - 1) / block + block;
+
+    // search of include/exclude tree limits number of items as well
+    if (table_size * tables * sizeof(int) > CARDINALITY_MEMORY_LIMIT) {
+        inst->solution = SearchDepth(view, inst, BOUND_MARTELLO_TOTH, NULL);
+        return;
+    }
+
+    std::vector<int> table(table_size, 0);
+    std::vector<std::vector<int>> checkpoints;
+
+    for (int i = 0; i < view.size; ++i) {
+        if (i % block == 0)
+            checkpoints.push_back(table);
+
+        AddCardinalityItem(&table, items, capacity, view.weight[i], view.cost[i]);
+    }
+
+    // backward from the whole table, value is the cost of remaining items
+    int k = items;
+    int c = capacity;
+    int value = table[(size_t)k * (capacity + 1) + c];
+    SolutionBits solution (view.size);
+    std::vector<std::vector<int>> states;
+
+    inst->sum_cost = value;
+
+    for (int b = checkpoints.size() - 1; b >= 0; --b) {
+        int first = b * block;
+        int last = std::min(view.size, first + block);
+
+        // states[j] is table in front of item first + j
+        states.assign(1, checkpoints[b]);
+
+        for (int i = first; i < last - 1; ++i) {
+            states.push_back(states.back());
+            AddCardinalityItem(&states.back(), items, capacity, view.weight[i], view.cost[i]);
+        }
+
+        for (int i = last - 1; i >= first; --i) {
+            // item was taken if cost can not be reached without it
+            if (states[i - first][(size_t)k * (capacity + 1) + c] < value) {
+                solution.Set(i, 1);
+                value -= view.cost[i];
+                c -= view.weight[i];
+                k--;
+            }
+        }
+
+        checkpoints.pop_back();
+    }
+
+    inst->solution = solution;
+}
+
+/**
+ * Updates table of cardinality constrained dynamic programming by one item.
+ *
+ * @param  table     the highest costs indexed by number of items and capacity
+ * @param  items     max number of items
+ * @param  capacity  capacity of knapsack
+ * @param  weight    weight of added item
+ * @param  cost      cost of added item
+ */
+void AddCardinalityItem(std::vector<int> * table, int items, int capacity, int weight, int cost) {
+    int width = capacity + 1;
+    int * t = table->data();
+
+    if (weight > capacity)
+        return;
+
+    // from the highest number of items, so previous row is not updated yet
+    for (int k = items; k >= 1; --k) {
+        int * row = t + (size_t)k * width;
+        const int * prev = t + (size_t)(k - 1) * width;
+
+        for (int c = capacity; c >= weight; --c)
+            row[c] = std::max(row[c], prev[c - weight] + cost);
+    }
+}
+
 /**
  * Deallocate all cells from table.
  *
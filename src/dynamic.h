@@ -7,10 +7,19 @@
 #ifndef DYNAMIC_H
 #define DYNAMIC_H
 
+#include <cmath>
+
+#include <stdint.h>
+
+#include "depth_search.h"
 #include "instances.h"
+#include "options.h"
+#include "pipeline.h"
 
 #define MIN_PARAM   2
 #define BEGIN       0
+#define WORD_BITS   64
+#define CARDINALITY_MEMORY_LIMIT (1 << 28)
 
 struct Cell {
     int cost;
@@ -25,18 +34,28 @@ struct Cell {
 };
 
 struct Solution {
-    std::vector<bool> solution_vector;
+    SolutionBits solution_vector;
     int cost;
 };
 
 void SolveDynamic(Instances * inst);
-std::vector<bool> Evaluate(Instance * inst, int capacity, int max_items);
+void SolveDynamicInstance(const InstanceView & view, Instance * inst);
+SolutionBits Evaluate(Instance * inst, int capacity, int max_items);
 Cell * CreateCell(int wi);
 Cell * ExistCell(std::vector<Cell *> * column, int weight);
-void PrintBinaryVector(std::vector<bool> * bv);
+void PrintBinaryVector(SolutionBits * bv);
 std::vector<std::vector<Cell *>> CreateNetwork(Instance * inst, int capacity);
 Solution SolveNetwork(Instance * inst, std::vector<std::vector<Cell *>> * table);
-std::vector<bool> FindPath(Cell * cell);
+SolutionBits FindPath(Cell * cell);
 void DeleteTable(std::vector<std::vector<Cell*>> * table);
 
+bool IsSubsetSum(const InstanceView & view);
+void SolveSubsetSumInstance(const InstanceView & view, Instance * inst);
+void ShiftOr(std::vector<uint64_t> * bits, int shift, int limit);
+bool TestBit(const std::vector<uint64_t> & bits, int index);
+int HighestBit(const std::vector<uint64_t> & bits);
+
+void SolveCardinalityInstance(const InstanceView & view, Instance * inst);
+void AddCardinalityItem(std::vector<int> * table, int items, int capacity, int weight, int cost);
+
 #endif //DYNAMIC_H
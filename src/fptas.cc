@@ -13,15 +13,26 @@
 #include "fptas.h"
 
 int main(int argc, char **argv) {
-    if (argc >= MIN_PARAM) {
-        char * file_name = argv[1];
-        int precision = atoi(argv[2]);
+    Options options;
 
-        auto inst = new Instances(file_name);
-        SolveFptas(inst, precision);
-        inst->PrintSolutions();
+    if (ParseOptions(argc, argv, MIN_PARAM, &options)) {
+        char * file_name = options.params.at(0);
+        int precision = atoi(options.params.at(1));
 
-        delete inst;
+        if (options.stream) {
+            auto solver = [precision](const InstanceView & view, Instance * inst) {
+                SolveFptasInstance(view, inst, precision);
+            };
+
+            SolveStream(file_name, solver, options.threads, options.binary);
+        }
+        else {
+            auto inst = new Instances(file_name, options.ids);
+            SolveFptas(inst, precision);
+            inst->PrintSolutions(options.binary);
+
+            delete inst;
+        }
     }
 
 
@@ -39,17 +50,25 @@ void SolveFptas(Instances * inst, int precision) {
     int volume = inst->GetVolume();
     int max_items = inst->GetMaxItems();
 
-    std::vector<Instance *> all_instances =  inst->GetAllInstances();
+    const std::vector<Instance *> & all_instances = inst->GetAllInstances();
 
     // reduction of precision
     ReducePrecisionInstances(all_instances, precision);
 
-    std::vector<bool> solution;
+    for (auto inst_it = all_instances.begin(); inst_it != all_instances.end(); ++inst_it)
+        (*inst_it)->solution = Evaluate(*inst_it, capacity, max_items);
+}
 
-    for (auto inst_it = all_instances.begin(); inst_it != all_instances.end(); ++inst_it) {
-        solution = Evaluate(*inst_it, capacity, max_items);
-        (*inst_it)->solution = solution;
-    }
+/**
+ * Solves one instance of knapsack problem by FPTAS method.
+ *
+ * @param   view       instance of knapsack problem
+ * @param   inst       instance where solution is stored
+ * @param   precision  number of LSB which we can ommit
+ */
+void SolveFptasInstance(const InstanceView & view, Instance * inst, int precision) {
+    ReducePrecisionInstances(std::vector<Instance *>(1, inst), precision);
+    inst->solution = Evaluate(inst, view.capacity, view.size);
 }
 
 /**
@@ -61,7 +80,7 @@ void SolveFptas(Instances * inst, int precision) {
  * @param  max_items  maximum number of items in knapsack
  * @return            binary vector, the best selection of items for knapsack
  */
-std::vector<bool> Evaluate(Instance * inst, int capacity, int max_items) {
+SolutionBits Evaluate(Instance * inst, int capacity, int max_items) {
     std::vector<int> weights = inst->weight;
 
     // create and compute network
@@ -70,7 +89,7 @@ std::vector<bool> Evaluate(Instance * inst, int capacity, int max_items) {
     // find final weight and cost
     Cell * c_w = FindCostWeight(&table, capacity);
 
-    std::vector<bool> solution = GetSolutionPath(&table, c_w, inst);
+    SolutionBits solution = GetSolutionPath(&table, c_w, inst);
 
 
     // set the best cost of particular knapsack configuration
@@ -221,18 +240,19 @@ bool TestCellWeight(Cell * c, int capacity) {
  * @param   inst   
  * @return         solution path
  */
-std::vector<bool> GetSolutionPath(std::vector<std::vector<Cell *>> * table, Cell * cell, Instance * inst) {
+SolutionBits GetSolutionPath(std::vector<std::vector<Cell *>> * table, Cell * cell, Instance * inst) {
     auto w_it = inst->weight.end()-1;
     auto col_it = table->begin()+1;
     int tmp_weight = cell->weight;
 
     Cell * forward_cell = cell;
 
-    std::vector<bool> path;
+    // items which are not visited stay zero
+    SolutionBits path(inst->weight.size());
 
     while (tmp_weight > 0) {
         if (forward_cell->forward == NULL) {
-            path.insert(path.begin(), 1);
+            path.Set(w_it - inst->weight.begin(), true);
 
             tmp_weight -= (*w_it);
 
@@ -242,7 +262,6 @@ std::vector<bool> GetSolutionPath(std::vector<std::vector<Cell *>> * table, Cell
             forward_cell = FindNextCell(&(*col_it), tmp_weight);
         }
         else {
-            path.insert(path.begin(), 0);
             forward_cell = forward_cell->forward;
         }
 
@@ -250,8 +269,6 @@ std::vector<bool> GetSolutionPath(std::vector<std::vector<Cell *>> * table, Cell
         ++col_it;
     }
 
-    path = RecoverPath(&path, inst->weight.size());
-
     return path;
 }
 
@@ -330,23 +347,6 @@ bool EqualCell(Cell * cell, int cost, int weight) {
         return false;
 }
 
-/**
- * Adds binary zeros to given path to extend binary solution to desired length.
- *
- * @param   path
- * @param   length  
- * @return          rovered path with right length of binary vector
- */
-std::vector<bool> RecoverPath(std::vector<bool> * path, int length) {
-    int d;
-    std::vector<bool> full_path = *path;
-
-    if ((d = length - path->size()) != 0)
-        for (int i = 0; i < d; ++i) full_path.insert(full_path.begin(), 0);
-
-    return full_path;
-}
-
 /**
  * Deallocated all cells from given table.
  *
@@ -364,7 +364,7 @@ void DeleteTable(std::vector<std::vector<Cell *>> & table) {
  * @param   instances
  * @param   precision
  */
-void ReducePrecisionInstances(std::vector<Instance *> & instances, int precision) {
+void ReducePrecisionInstances(const std::vector<Instance *> & instances, int precision) {
     // cost
     for (auto i_it = instances.begin(); i_it != instances.end(); ++i_it)
         for (auto c_it = (*i_it)->cost.begin(); c_it != (*i_it)->cost.end(); ++c_it)
@@ -378,16 +378,8 @@ void ReducePrecisionInstances(std::vector<Instance *> & instances, int precision
  * @param   solution  
  * @return            sum of costs from final configuration
  */
-int GetSumCost(Instance * inst, std::vector<bool> solution) {
-    int sum_cost = 0;
-
-    auto b_it = solution.begin();
-    for (auto it = inst->cost.begin(); it != inst->cost.end(); ++it, ++b_it) {
-        if (*b_it)
-            sum_cost += *it;
-    }
-
-    return sum_cost;
+int GetSumCost(Instance * inst, const SolutionBits & solution) {
+    return solution.Dot(inst->cost.data());
 }
 
 /**
@@ -395,9 +387,9 @@ int GetSumCost(Instance * inst, std::vector<bool> solution) {
  *
  * @param  bv  binary vector
  */
-void PrintBinaryVector(std::vector<bool> * bv) {
-    for (auto it = bv->begin(); it != bv->end(); ++it)
-        std::cout << *it;
+void PrintBinaryVector(SolutionBits * bv) {
+    for (size_t i = 0; i < bv->Size(); ++i)
+        std::cout << bv->Get(i);
 
     std::cout << std::endl;
 }
@@ -11,6 +11,8 @@
 #include <stdlib.h>
 
 #include "instances.h"
+#include "options.h"
+#include "pipeline.h"
 
 #define MIN_PARAM    3
 #define BITS        20
@@ -24,29 +26,29 @@ struct Cell {
 };
 
 struct Solution {
-    std::vector<bool> solution_vector;
+    SolutionBits solution_vector;
     int cost;
 };
 
 void SolveFptas(Instances * inst, int precision);
+void SolveFptasInstance(const InstanceView & view, Instance * inst, int precision);
 std::vector<std::vector<Cell *>> CreateNetwork(Instance * inst, int capacity);
-std::vector<bool> Evaluate(Instance * inst, int capacity, int max_items);
+SolutionBits Evaluate(Instance * inst, int capacity, int max_items);
 std::vector<std::vector<Cell *>> CreateNetwork(Instance * inst, int capacity);
 Cell * CreateCell(int c, int w, Cell * p_c);
 bool TestCellWeight(Cell * c, int capacity);
 Cell * CompareCells(Cell * c1, Cell * c2);
-std::vector<bool> GetSolutionPath(std::vector<std::vector<Cell *>> * table, Cell* cell, Instance * inst);
+SolutionBits GetSolutionPath(std::vector<std::vector<Cell *>> * table, Cell* cell, Instance * inst);
 Cell * FindCostWeight(std::vector<std::vector<Cell*>>* table, int capacity);
 Cell * FindNextCell(std::vector<Cell *> * column, int weight);
 void PrintCell(Cell * cell);
-std::vector<bool> RecoverPath(std::vector<bool> * path, int length);
-void PrintBinaryVector(std::vector<bool> * bv);
+void PrintBinaryVector(SolutionBits * bv);
 void  PrintColumn(std::vector<Cell *> & column);
 bool ExistCell(std::vector<Cell *> & column, int cost, int weight);
 bool EqualCell(Cell * cell, int cost, int weight);
 void DeleteTable(std::vector<std::vector<Cell *>> & table);
-void ReducePrecisionInstances(std::vector<Instance *> & instances, int precision);
-int GetSumCost(Instance * inst, std::vector<bool> solution);
+void ReducePrecisionInstances(const std::vector<Instance *> & instances, int precision);
+int GetSumCost(Instance * inst, const SolutionBits & solution);
 
 bit CreateMask(int l);
 bit ReducePrecision(int n, int p);
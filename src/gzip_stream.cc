@@ -0,0 +1,101 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ *
+ * @section DESCRIPTION
+ *
+ * Reading of gzip compressed files through standard streams.
+ */
+
+#include "gzip_stream.h"
+
+/**
+ * Checks if given file starts with gzip magic number.
+ */
+bool IsGzipFile(const char * file_name) {
+    std::ifstream file(file_name, std::ios::binary);
+    unsigned char magic[2] = {0, 0};
+
+    file.read(reinterpret_cast<char *>(magic), 2);
+
+    return file.good() && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+GzStreamBuf::GzStreamBuf() : file(NULL), failed(false) {}
+
+GzStreamBuf::~GzStreamBuf() {
+    if (this->file != NULL)
+        gzclose(this->file);
+}
+
+/**
+ * Opens file for reading.
+ */
+bool GzStreamBuf::Open(const char * file_name) {
+    this->file = gzopen(file_name, "rb");
+
+    if (this->file == NULL)
+        return false;
+
+    gzbuffer(this->file, GZIP_BUFFER_SIZE);
+
+    return true;
+}
+
+/**
+ * Error of decompression, file is read only up to damaged block.
+ */
+const char * GzStreamBuf::Error() const {
+    if (!this->failed)
+        return NULL;
+
+    int errnum;
+
+    return gzerror(this->file, &errnum);
+}
+
+/**
+ * Refills buffer with next decompressed block.
+ */
+GzStreamBuf::int_type GzStreamBuf::underflow() {
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    if (this->failed)
+        return traits_type::eof();
+
+    int n = gzread(this->file, this->buffer, GZIP_BUFFER_SIZE);
+
+    if (n <= 0) {
+        int errnum = Z_OK;
+        gzerror(this->file, &errnum);
+
+        // corrupted file fails, truncated one ends without error but with
+        // Z_BUF_ERROR; error is kept for Error()
+        this->failed = n < 0 || errnum != Z_OK;
+
+        return traits_type::eof();
+    }
+
+    setg(this->buffer, this->buffer, this->buffer + n);
+
+    return traits_type::to_int_type(*gptr());
+}
+
+/**
+ * Constructor. Opens given file, failbit is set if it can not be opened.
+ */
+GzInputStream::GzInputStream(const char * file_name) : std::istream(NULL) {
+    if (this->buf.Open(file_name))
+        rdbuf(&this->buf);
+    else
+        setstate(std::ios::failbit);
+}
+
+/**
+ * Error of decompression.
+ */
+const char * GzInputStream::Error() const {
+    return this->buf.Error();
+}
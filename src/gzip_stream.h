@@ -0,0 +1,86 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ */
+
+#ifndef GZIP_STREAM_HH
+#define GZIP_STREAM_HH
+
+#include <fstream>
+#include <istream>
+#include <streambuf>
+
+#include <zlib.h>
+
+#define GZIP_BUFFER_SIZE  (1 << 17)
+
+/**
+ * Checks if given file starts with gzip magic number.
+ *
+ * @param   file_name  name of file
+ * @return             true for gzip compressed file
+ */
+bool IsGzipFile(const char * file_name);
+
+/**
+ * Stream buffer which decompresses gzip file on the fly. Files which are not
+ * compressed are read without any change.
+ */
+class GzStreamBuf : public std::streambuf {
+    public:
+        GzStreamBuf();
+        ~GzStreamBuf();
+
+        /**
+         * Opens file for reading.
+         *
+         * @param   file_name  name of file
+         * @return             false if file can not be opened
+         */
+        bool Open(const char * file_name);
+
+        /**
+         * Error of decompression, file is read only up to damaged block.
+         *
+         * @return  description of error, NULL if file was read without error
+         */
+        const char * Error() const;
+
+    protected:
+        /**
+         * Refills buffer with next decompressed block.
+         */
+        int_type underflow();
+
+    private:
+        gzFile file;
+        bool failed;  // gzread failed, stream ends
+        char buffer[GZIP_BUFFER_SIZE];
+};
+
+/**
+ * Input stream reading gzip compressed or plain file.
+ */
+class GzInputStream : public std::istream {
+    public:
+        /**
+         * Constructor. Opens given file, failbit is set if it can not be opened.
+         *
+         * @param  file_name  name of file
+         */
+        GzInputStream(const char * file_name);
+
+        /**
+         * Error of decompression. Truncated or corrupted file ends stream like
+         * end of file, so it has to be checked when reading is finished.
+         *
+         * @return  description of error, NULL if file was read without error
+         */
+        const char * Error() const;
+
+    private:
+        GzStreamBuf buf;
+};
+
+#endif //GZIP_STREAM_HH
@@ -14,14 +14,29 @@
 
 
 int main(int argc, char** argv) {
+    Options options;
 
-    if (argc >= MIN_PARAM) {
-        char * file_name = argv[1];
-        auto inst = new Instances(file_name);
-        SolveHeuristic(inst);
-        inst->PrintSolutions();
+    if (ParseOptions(argc, argv, MIN_PARAM, &options)) {
+        char * file_name = options.params.at(0);
+        HeuristicKernel kernel = ParseKernel(options.kernel);
 
-        delete inst;
+        if (options.stream) {
+            auto solver = [kernel](const InstanceView & view, Instance * inst) {
+                SolveGreedyInstance(view, inst, kernel);
+            };
+
+            SolveStream(file_name, solver, options.threads, options.binary);
+        }
+        else {
+            auto inst = new Instances(file_name, options.ids);
+            SolveHeuristic(inst, kernel);
+            inst->PrintSolutions(options.binary);
+
+            if (kernel != KERNEL_RATIO)
+                PrintBounds(inst);
+
+            delete inst;
+        }
     }
 
     return EXIT_SUCCESS;
@@ -32,45 +47,344 @@ int main(int argc, char** argv) {
  * of cost/weight, then this values are sorted and chosen first X values which still
  * fits to knapsack.
  */
-void SolveHeuristic(Instances * inst) {
+void SolveHeuristic(Instances * inst, HeuristicKernel kernel) {
+    const InstanceBatch & batch = inst->GetBatch();
+
+    for (size_t i = 0; i < batch.Size(); ++i)
+        SolveGreedyInstance(batch.View(i), inst->GetInstance(i), kernel);
+}
+
+/**
+ * Solves one instance of knapsack problem by selected greedy method.
+ */
+void SolveGreedyInstance(const InstanceView & view, Instance * inst, HeuristicKernel kernel) {
+    if (kernel == KERNEL_CRITICAL)
+        SolveCriticalInstance(view, inst);
+    else if (kernel == KERNEL_IMPROVE)
+        SolveImproveInstance(view, inst);
+    else
+        SolveHeuristicInstance(view, inst);
+}
+
+/**
+ * Solves one instance of knapsack problem using heuristic.
+ */
+void SolveHeuristicInstance(const InstanceView & view, Instance * inst) {
     std::vector<float> heuristic;
     std::vector<float> order;
-    int tmp_cost;
-    int tmp_weight;
+    int tmp_cost = 0;
+    int tmp_weight = 0;
     int index;
-    int sum_cost;
-    int volume = inst->GetVolume();
-    int capacity = inst->GetCapacity();
-
-    inst->ComputeHeuristic();
-    std::vector<Instance *> all_instances = inst->GetAllInstances();
-
-    for (auto inst_it = all_instances.begin(); inst_it != all_instances.end(); ++inst_it) {
-        std::vector<bool> solution ((*inst_it)->weight.size(), 0);
-        tmp_cost = 0;
-        tmp_weight = 0;
-        sum_cost = 0;
-        heuristic = (*inst_it)->heuristic;
-
-        // sort of computed heuristics
-        order = inst->OrderVector(heuristic);
-        std::reverse(order.begin(), order.end());
-
-        for (auto o_it = order.begin(); o_it != order.end(); ++o_it) {
-            index = *o_it;
-            tmp_cost += (*inst_it)->cost.at(index);
-            tmp_weight += (*inst_it)->weight.at(index);
-
-            // is knapsack full?
-            if (tmp_weight > capacity)
-                break;
-
-            solution.at(index) = 1;
-            sum_cost = tmp_cost;
+    int sum_cost = 0;
+    int capacity = view.capacity;
+
+    SolutionBits solution (view.size);
+
+    // ratio of cost/weight
+    for (int i = 0; i < view.size; ++i)
+        heuristic.push_back(view.cost[i] / view.weight[i]);
+
+    // sort of computed heuristics
+    order = Instances::OrderVector(heuristic);
+    std::reverse(order.begin(), order.end());
+
+    for (auto o_it = order.begin(); o_it != order.end(); ++o_it) {
+        index = *o_it;
+        tmp_cost += view.cost[index];
+        tmp_weight += view.weight[index];
+
+        // is knapsack full?
+        if (tmp_weight > capacity)
+            break;
+
+        solution.Set(index, 1);
+        sum_cost = tmp_cost;
+    }
+
+    inst->sum_cost = sum_cost;
+    inst->solution = solution;
+}
+
+/**
+ * Solves one instance of knapsack problem by critical item greedy method.
+ */
+void SolveCriticalInstance(const InstanceView & view, Instance * inst) {
+    std::vector<int> order;
+    int cost = 0;
+    int weight = 0;
+    int critical = FindCriticalItem(view, &order, &cost, &weight);
+
+    SolutionBits solution (view.size);
+
+    for (int i = 0; i < critical; ++i)
+        solution.Set(order[i], 1);
+
+    // LP relaxation takes fraction of critical item
+    long long bound = cost;
+
+    if (critical < view.size) {
+        int index = order[critical];
+        bound += (long long)(view.capacity - weight) * view.cost[index] / view.weight[index];
+    }
+
+    inst->sum_cost = cost;
+    inst->upper_bound = bound;
+    inst->solution = solution;
+}
+
+/**
+ * Solves one instance of knapsack problem by improvement of greedy solution.
+ */
+void SolveImproveInstance(const InstanceView & view, Instance * inst) {
+    SolveCriticalInstance(view, inst);
+
+    SolutionBits solution = inst->solution;
+    int cost = inst->sum_cost;
+    int weight = 0;
+    int best_item = -1;
+
+    for (int i = 0; i < view.size; ++i) {
+        if (solution.Get(i))
+            weight += view.weight[i];
+
+        if (view.weight[i] <= view.capacity && (best_item < 0 || view.cost[i] > view.cost[best_item]))
+            best_item = i;
+    }
+
+    // the most valuable single item
+    if (best_item >= 0 && view.cost[best_item] > cost) {
+        solution = SolutionBits(view.size);
+        solution.Set(best_item, 1);
+        cost = view.cost[best_item];
+        weight = view.weight[best_item];
+    }
+
+    ImproveSolution(view, &solution, &cost, &weight);
+
+    inst->sum_cost = cost;
+    inst->solution = solution;
+}
+
+/**
+ * Alternates adding of fitting items and exchanges of items.
+ */
+void ImproveSolution(const InstanceView & view, SolutionBits * solution, int * cost, int * weight) {
+    FillSolution(view, solution, cost, weight);
+
+    for (int pass = 0; pass < IMPROVE_PASSES; ++pass) {
+        if (!ExchangeItems(view, solution, cost, weight))
+            break;
+
+        FillSolution(view, solution, cost, weight);
+    }
+}
+
+/**
+ * Adds items which fit to remaining capacity.
+ */
+void FillSolution(const InstanceView & view, SolutionBits * solution, int * cost, int * weight) {
+    std::vector<int> fitting;
+
+    for (int i = 0; i < view.size; ++i)
+        if (!solution->Get(i) && *weight + view.weight[i] <= view.capacity)
+            fitting.push_back(i);
+
+    std::sort(fitting.begin(), fitting.end(), [&view](int a, int b) {
+        return (long long)view.cost[a] * view.weight[b] > (long long)view.cost[b] * view.weight[a];
+    });
+
+    for (auto i : fitting) {
+        if (*weight + view.weight[i] <= view.capacity) {
+            solution->Set(i, 1);
+            *cost += view.cost[i];
+            *weight += view.weight[i];
         }
+    }
+}
+
+/**
+ * Performs the best exchange of items in and out of knapsack.
+ */
+bool ExchangeItems(const InstanceView & view, SolutionBits * solution, int * cost, int * weight) {
+    auto higher_ratio = [&view](int a, int b) {
+        return (long long)view.cost[a] * view.weight[b] > (long long)view.cost[b] * view.weight[a];
+    };
+
+    std::vector<int> in;
+    std::vector<int> out;
+
+    for (int i = 0; i < view.size; ++i) {
+        if (solution->Get(i))
+            in.push_back(i);
+        else
+            out.push_back(i);
+    }
+
+    // candidates are items in knapsack with the lowest ratios and items out
+    // of knapsack with the highest ratios
+    if (in.size() > IMPROVE_WINDOW) {
+        std::nth_element(in.begin(), in.end() - IMPROVE_WINDOW, in.end(), higher_ratio);
+        in.erase(in.begin(), in.end() - IMPROVE_WINDOW);
+    }
+
+    if (out.size() > IMPROVE_WINDOW) {
+        std::nth_element(out.begin(), out.begin() + IMPROVE_WINDOW, out.end(), higher_ratio);
+        out.resize(IMPROVE_WINDOW);
+    }
+
+    std::vector<ItemGroup> drop = CreateGroups(view, in);
+    std::vector<ItemGroup> add = CreateGroups(view, out);
+
+    // the most valuable added group up to given weight
+    std::sort(add.begin(), add.end(), [](const ItemGroup & a, const ItemGroup & b) {
+        return a.weight < b.weight;
+    });
+
+    std::vector<int> best_add(add.size());
+
+    for (size_t i = 0; i < add.size(); ++i)
+        best_add[i] = (i > 0 && add[best_add[i - 1]].cost >= add[i].cost) ? best_add[i - 1] : i;
+
+    int best_gain = 0;
+    int best_drop = -1;
+    int best_added = -1;
+
+    for (size_t d = 0; d < drop.size(); ++d) {
+        int free = view.capacity - *weight + drop[d].weight;
+
+        auto it = std::upper_bound(add.begin(), add.end(), free, [](int w, const ItemGroup & g) {
+            return w < g.weight;
+        });
+
+        if (it == add.begin())
+            continue;
+
+        int a = best_add[it - add.begin() - 1];
+        int gain = add[a].cost - drop[d].cost;
+
+        if (gain > best_gain) {
+            best_gain = gain;
+            best_drop = d;
+            best_added = a;
+        }
+    }
+
+    if (best_gain == 0)
+        return false;
+
+    const ItemGroup & d = drop[best_drop];
+    const ItemGroup & a = add[best_added];
+
+    for (int i : {d.first, d.second})
+        if (i >= 0) solution->Set(i, 0);
+
+    for (int i : {a.first, a.second})
+        if (i >= 0) solution->Set(i, 1);
+
+    *cost += a.cost - d.cost;
+    *weight += a.weight - d.weight;
+
+    return true;
+}
+
+/**
+ * Creates all groups of up to two items.
+ */
+std::vector<ItemGroup> CreateGroups(const InstanceView & view, const std::vector<int> & items) {
+    std::vector<ItemGroup> groups;
+    ItemGroup empty = {0, 0, -1, -1};
+
+    groups.push_back(empty);
+
+    for (size_t i = 0; i < items.size(); ++i) {
+        int first = items[i];
+        ItemGroup single = {view.cost[first], view.weight[first], first, -1};
+        groups.push_back(single);
+
+        for (size_t j = i + 1; j < items.size(); ++j) {
+            int second = items[j];
+            ItemGroup pair = {view.cost[first] + view.cost[second],
+                              view.weight[first] + view.weight[second],
+                              first, second};
+            groups.push_back(pair);
+        }
+    }
+
+    return groups;
+}
+
+/**
+ * Finds critical item by partitioning of ratios.
+ */
+int FindCriticalItem(const InstanceView & view, std::vector<int> * order, int * cost, int * weight) {
+    // ratios are compared by cross multiplication, no rounding is involved
+    auto higher_ratio = [&view](int a, int b) {
+        return (long long)view.cost[a] * view.weight[b] > (long long)view.cost[b] * view.weight[a];
+    };
+
+    order->resize(view.size);
+    std::iota(order->begin(), order->end(), 0);
+
+    *cost = 0;
+    *weight = 0;
+
+    // critical position is always within [low, high]
+    int low = 0;
+    int high = view.size;
+
+    while (low < high) {
+        int middle = low + (high - low) / 2;
+        std::nth_element(order->begin() + low, order->begin() + middle, order->begin() + high, higher_ratio);
+
+        long long part_cost = 0;
+        long long part_weight = 0;
+
+        for (int i = low; i <= middle; ++i) {
+            part_cost += view.cost[(*order)[i]];
+            part_weight += view.weight[(*order)[i]];
+        }
+
+        // items up to median fit, critical item is behind median
+        if (*weight + part_weight <= view.capacity) {
+            *cost += part_cost;
+            *weight += part_weight;
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * Translates name of greedy method given on command line.
+ */
+HeuristicKernel ParseKernel(const char * name) {
+    if (name == NULL || strcmp(name, "ratio") == 0)
+        return KERNEL_RATIO;
+
+    if (strcmp(name, "critical") == 0)
+        return KERNEL_CRITICAL;
+
+    if (strcmp(name, "improve") == 0)
+        return KERNEL_IMPROVE;
+
+    std::cerr << "Unknown kernel " << name << std::endl;
+    exit(EXIT_FAILURE);
+}
+
+/**
+ * Prints upper bounds and gaps on standard error output, one instance per
+ * line: ID, cost of solution, upper bound and gap.
+ */
+void PrintBounds(Instances * inst) {
+    const std::vector<Instance *> & all_instances = inst->GetAllInstances();
 
-        (*inst_it)->sum_cost = sum_cost;
-        (*inst_it)->solution = solution;
+    for (auto i : all_instances) {
+        std::cerr << i->id << " " << i->sum_cost << " " << i->upper_bound << " "
+                  << i->upper_bound - i->sum_cost << std::endl;
     }
 }
 
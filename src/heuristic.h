@@ -10,8 +10,38 @@
 #include <algorithm>
 
 #include "instances.h"
+#include "options.h"
+#include "pipeline.h"
 
 #define MIN_PARAM 2
+#define IMPROVE_WINDOW 32
+#define IMPROVE_PASSES 1000
+
+/**
+ * Greedy methods, selected by -k option.
+ *
+ * ratio     items are sorted by integer ratio of cost/weight (default)
+ * critical  Balas-Zemel search of critical item by partitioning of ratios
+ *           in expected linear time; upper bound from LP relaxation is
+ *           computed as well
+ * improve   critical item greedy or the most valuable single item, the
+ *           better one, improved by add, drop and swap moves
+ */
+enum HeuristicKernel {
+    KERNEL_RATIO,
+    KERNEL_CRITICAL,
+    KERNEL_IMPROVE
+};
+
+/**
+ * Up to two items which are dropped from or added to knapsack together.
+ */
+struct ItemGroup {
+    int cost;
+    int weight;
+    int first;   // index of item, -1 if group is empty
+    int second;  // index of item, -1 if group has less than two items
+};
 
 /**
  * Solves knapsack problem using heuristic. For all items is computed ratio 
@@ -20,7 +50,119 @@
  *
  * @param  inst  pointer to Instances object
  */
-void SolveHeuristic(Instances * inst);
+void SolveHeuristic(Instances * inst, HeuristicKernel kernel);
+
+/**
+ * Solves one instance of knapsack problem by selected greedy method.
+ *
+ * @param  view    instance of knapsack problem
+ * @param  inst    instance where solution is stored
+ * @param  kernel  greedy method
+ */
+void SolveGreedyInstance(const InstanceView & view, Instance * inst, HeuristicKernel kernel);
+
+/**
+ * Solves one instance of knapsack problem using heuristic.
+ *
+ * @param  view  instance of knapsack problem
+ * @param  inst  instance where solution is stored
+ */
+void SolveHeuristicInstance(const InstanceView & view, Instance * inst);
+
+/**
+ * Solves one instance of knapsack problem by greedy method which takes
+ * items with the highest ratio of cost/weight until the critical item,
+ * the first one which does not fit. Stores also upper bound from LP
+ * relaxation.
+ *
+ * @param  view  instance of knapsack problem
+ * @param  inst  instance where solution is stored
+ */
+void SolveCriticalInstance(const InstanceView & view, Instance * inst);
+
+/**
+ * Solves one instance of knapsack problem by improvement of greedy
+ * solution. The start is the better one of critical item greedy and the
+ * most valuable single item, which guarantees at least half of optimal
+ * cost.
+ *
+ * @param  view  instance of knapsack problem
+ * @param  inst  instance where solution is stored
+ */
+void SolveImproveInstance(const InstanceView & view, Instance * inst);
+
+/**
+ * Alternates adding of fitting items and exchanges of items until no
+ * move improves solution.
+ *
+ * @param  view      instance of knapsack problem
+ * @param  solution  improved solution
+ * @param  cost      sum of costs of solution
+ * @param  weight    sum of weights of solution
+ */
+void ImproveSolution(const InstanceView & view, SolutionBits * solution, int * cost, int * weight);
+
+/**
+ * Adds items which fit to remaining capacity in decreasing order of ratio.
+ *
+ * @param  view      instance of knapsack problem
+ * @param  solution  improved solution
+ * @param  cost      sum of costs of solution
+ * @param  weight    sum of weights of solution
+ */
+void FillSolution(const InstanceView & view, SolutionBits * solution, int * cost, int * weight);
+
+/**
+ * Performs the best exchange of up to two items in knapsack with the
+ * lowest ratios for up to two items out of knapsack with the highest
+ * ratios. Gain of every exchange is computed in O(1) from sums of groups.
+ *
+ * @param   view      instance of knapsack problem
+ * @param   solution  improved solution
+ * @param   cost      sum of costs of solution
+ * @param   weight    sum of weights of solution
+ * @return            true if solution was improved
+ */
+bool ExchangeItems(const InstanceView & view, SolutionBits * solution, int * cost, int * weight);
+
+/**
+ * Creates all groups of up to two items from given items.
+ *
+ * @param   view   instance of knapsack problem
+ * @param   items  indexes of items
+ * @return         groups including the empty one
+ */
+std::vector<ItemGroup> CreateGroups(const InstanceView & view, const std::vector<int> & items);
+
+/**
+ * Finds critical item without sorting of all items. Median of ratios of
+ * remaining items partitions them and only the part containing critical
+ * item is examined further, which needs expected O(n) time.
+ *
+ * @param   view    instance of knapsack problem
+ * @param   order   indexes of items; items in front of critical position
+ *                  have the highest ratios and fit to knapsack
+ * @param   cost    sum of costs of items in front of critical position
+ * @param   weight  sum of weights of items in front of critical position
+ * @return          critical position in order, size of instance if all items fit
+ */
+int FindCriticalItem(const InstanceView & view, std::vector<int> * order, int * cost, int * weight);
+
+/**
+ * Translates name of greedy method given on command line.
+ *
+ * @param   name  name of method, NULL for default one
+ * @return        greedy method
+ */
+HeuristicKernel ParseKernel(const char * name);
+
+/**
+ * Prints upper bounds and gaps between them and found solutions on
+ * standard error output.
+ *
+ * @param  inst  solved instances
+ */
+void PrintBounds(Instances * inst);
 
 /**
  * Prints vector of float values on line with space between numbers.
@@ -0,0 +1,197 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ *
+ * @section DESCRIPTION
+ *
+ * KNAPSACK PROBLEM 
+ *
+ * Sidecar index mapping ID of instance to its position in text file.
+ */
+
+#include "index.h"
+#include "instances.h"
+
+/**
+ * Constructor. Creates empty index.
+ */
+InstanceIndex::InstanceIndex() : entries(NULL), count(0), mapped(NULL), mapped_size(0) {}
+
+/**
+ * Destructor.
+ *
+ * Unmaps loaded index file.
+ */
+InstanceIndex::~InstanceIndex() {
+    if (this->mapped != NULL)
+        munmap(this->mapped, this->mapped_size);
+}
+
+/**
+ * Opens index of given instance file.
+ */
+bool InstanceIndex::Open(const char * file_name) {
+    struct stat st;
+    std::string index_name = std::string(file_name) + INDEX_SUFFIX;
+
+    if (stat(file_name, &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+
+    if (Load(index_name, st))
+        return true;
+
+    if (!Build(file_name, st))
+        return false;
+
+    // index is used even if it can not be stored
+    Store(index_name, st);
+
+    return true;
+}
+
+/**
+ * Finds instance with given ID.
+ */
+bool InstanceIndex::Find(int id, IndexEntry * entry) const {
+    const IndexEntry * end = this->entries + this->count;
+    const IndexEntry * it = std::lower_bound(this->entries, end, id,
+            [](const IndexEntry & e, int id) { return e.id < id; });
+
+    if (it == end || it->id != id)
+        return false;
+
+    *entry = *it;
+
+    return true;
+}
+
+/**
+ * Maps sidecar index to memory and checks that it matches indexed file.
+ */
+bool InstanceIndex::Load(const std::string & index_name, const struct stat & st) {
+    struct stat index_st;
+    int fd = open(index_name.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    if (fstat(fd, &index_st) != 0 || (size_t)index_st.st_size < sizeof(IndexHeader)) {
+        close(fd);
+        return false;
+    }
+
+    void * data = mmap(NULL, index_st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    const IndexHeader * header = static_cast<const IndexHeader *>(data);
+
+    // stale or corrupted index
+    if (memcmp(header->magic, INDEX_MAGIC, 4) != 0 ||
+        header->version != INDEX_VERSION ||
+        header->file_size != (uint64_t)st.st_size ||
+        header->mtime_sec != (int64_t)st.st_mtim.tv_sec ||
+        header->mtime_nsec != (int64_t)st.st_mtim.tv_nsec ||
+        sizeof(IndexHeader) + header->count * sizeof(IndexEntry) > (size_t)index_st.st_size) {
+        munmap(data, index_st.st_size);
+        return false;
+    }
+
+    this->mapped = data;
+    this->mapped_size = index_st.st_size;
+    this->entries = reinterpret_cast<const IndexEntry *>(header + 1);
+    this->count = header->count;
+
+    return true;
+}
+
+/**
+ * Builds index by scanning all lines of instance file.
+ */
+bool InstanceIndex::Build(const char * file_name, const struct stat & st) {
+    int fd = open(file_name, O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    if (st.st_size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void * data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    const char * begin = static_cast<const char *>(data);
+    const char * end = begin + st.st_size;
+    const char * line = begin;
+    const char * line_end = NULL;
+    const char * p = NULL;
+    IndexEntry entry;
+    int id;
+
+    // binary and gzip compressed instance files are not indexed
+    if (((size_t)st.st_size >= sizeof(BinaryHeader) && memcmp(begin, BINARY_MAGIC, 4) == 0) ||
+        (st.st_size >= 2 && (unsigned char)begin[0] == 0x1f && (unsigned char)begin[1] == 0x8b)) {
+        munmap(data, st.st_size);
+        return false;
+    }
+
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+    while (line < end) {
+        line_end = static_cast<const char *>(memchr(line, '\n', end - line));
+
+        if (line_end == NULL)
+            line_end = end;
+
+        // empty lines are skipped
+        p = line;
+        if (Instances::ParseInt(&p, line_end, &id)) {
+            entry.id = id;
+            entry.length = line_end - line;
+            entry.offset = line - begin;
+            this->built.push_back(entry);
+        }
+
+        line = line_end + 1;
+    }
+
+    munmap(data, st.st_size);
+
+    // the first occurrence of ID is kept for duplicate IDs
+    std::stable_sort(this->built.begin(), this->built.end(),
+            [](const IndexEntry & a, const IndexEntry & b) { return a.id < b.id; });
+
+    this->entries = this->built.data();
+    this->count = this->built.size();
+
+    return true;
+}
+
+/**
+ * Stores built index to sidecar file.
+ */
+void InstanceIndex::Store(const std::string & index_name, const struct stat & st) {
+    std::ofstream file(index_name.c_str(), std::ios::binary);
+
+    if (!file.good())
+        return;
+
+    IndexHeader header;
+    memcpy(header.magic, INDEX_MAGIC, 4);
+    header.version = INDEX_VERSION;
+    header.file_size = st.st_size;
+    header.mtime_sec = st.st_mtim.tv_sec;
+    header.mtime_nsec = st.st_mtim.tv_nsec;
+    header.count = this->count;
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(IndexHeader));
+    file.write(reinterpret_cast<const char *>(this->entries), this->count * sizeof(IndexEntry));
+}
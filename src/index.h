@@ -0,0 +1,115 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ */
+
+#ifndef INDEX_HH
+#define INDEX_HH
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Sidecar index of text instance file, stored next to it as <file>.idx.
+ *
+ * File starts with IndexHeader followed by IndexEntry for every instance,
+ * entries are sorted by ID. Index is valid only if size and modification
+ * time of instance file match values stored in header.
+ */
+#define INDEX_MAGIC     "KNPI"
+#define INDEX_VERSION   1
+#define INDEX_SUFFIX    ".idx"
+
+struct IndexHeader {
+    char magic[4];                 // INDEX_MAGIC
+    uint32_t version;              // INDEX_VERSION
+    uint64_t file_size;            // size of indexed file
+    int64_t mtime_sec;             // modification time of indexed file
+    int64_t mtime_nsec;
+    uint64_t count;                // number of entries
+};
+
+struct IndexEntry {
+    int32_t id;                    // ID of instance
+    uint32_t length;               // length of line without new line character
+    uint64_t offset;               // offset of line in indexed file
+};
+
+class InstanceIndex {
+    public:
+        /**
+         * Constructor. Creates empty index.
+         */
+        InstanceIndex();
+
+        /**
+         * Destructor.
+         *
+         * Unmaps loaded index file.
+         */
+        ~InstanceIndex();
+
+        /**
+         * Opens index of given instance file. Valid sidecar index is mapped
+         * to memory, otherwise index is built and stored as new sidecar.
+         *
+         * @param   file_name  name of text file with instances
+         * @return             false if index could not be loaded nor built
+         */
+        bool Open(const char * file_name);
+
+        /**
+         * Finds instance with given ID.
+         *
+         * @param   id     ID of instance
+         * @param   entry  found entry
+         * @return         false if there is no instance with given ID
+         */
+        bool Find(int id, IndexEntry * entry) const;
+
+    private:
+        /**
+         * Maps sidecar index to memory and checks that it matches indexed file.
+         *
+         * @param   index_name  name of index file
+         * @param   st          status of indexed file
+         * @return              false if index is missing or stale
+         */
+        bool Load(const std::string & index_name, const struct stat & st);
+
+        /**
+         * Builds index by scanning all lines of instance file.
+         *
+         * @param   file_name  name of text file with instances
+         * @param   st         status of indexed file
+         * @return             false if file is not text file with instances
+         */
+        bool Build(const char * file_name, const struct stat & st);
+
+        /**
+         * Stores built index to sidecar file.
+         *
+         * @param   index_name  name of index file
+         * @param   st          status of indexed file
+         */
+        void Store(const std::string & index_name, const struct stat & st);
+
+        std::vector<IndexEntry> built;  // entries of built index
+        const IndexEntry * entries;     // entries sorted by ID
+        size_t count;                   // number of entries
+
+        void * mapped;                  // mapped index file
+        size_t mapped_size;
+};
+
+#endif //INDEX_HH
@@ -19,24 +19,19 @@
  * Checks if given file name exist, parse lines of that file and creates instances.
  *
  */
-Instances::Instances(const char * file_name) {
-    std::vector<std::string> * params = NULL;
-    Instance * inst = NULL;
-
+Instances::Instances(const char * file_name, const std::vector<int> & ids) : materialized(false) {
     if (ExistFile(file_name)) {
-        // read lines from file
-        std::ifstream file(file_name);
-        std::string line; 
-
-        // parse line and create instances
-        while (std::getline(file, line))
-        {
-            params = ParseLine(line);
-            inst = InitializeInstance(params);
-            PushInstance(inst);
-            delete params;
+        if (ids.empty() || !LoadIndexed(file_name, ids)) {
+            // regular files are mapped to memory, the rest is read line by line
+            if (IsGzipFile(file_name) || !LoadMappedFile(file_name))
+                LoadStreamFile(file_name);
+
+            if (!ids.empty())
+                FilterInstances(ids);
         }
     }
+
+    CreateInstances();
 }
 
 /**
@@ -71,52 +66,62 @@ int Instances::GetCapacity() {
 }
 
 /**
- * Getter of all instances needed to be solved.
+ * Getter of all instances needed to be solved. Weights and costs are
+ * copied from batch to instances when called for the first time.
  */
-std::vector<Instance *> Instances::GetAllInstances() {
+const std::vector<Instance *> & Instances::GetAllInstances() {
+    if (!this->materialized) {
+        for (size_t i = 0; i < this->batch.Size(); ++i) {
+            InstanceView view = this->batch.View(i);
+            Instance * inst = this->all_instances.at(i);
+
+            inst->weight.assign(view.weight, view.weight + view.size);
+            inst->cost.assign(view.cost, view.cost + view.size);
+        }
+
+        this->materialized = true;
+    }
+
     return this->all_instances;
 }
 
 /**
- * Prints solutions of all instances.
+ * Getter of batch with weights and costs of all instances.
  */
-void Instances::PrintSolutions() {
-    Instance * inst = NULL;
-    std::string space = " ";
-
-    for (auto inst_it = this->all_instances.begin(); inst_it != this->all_instances.end(); ++inst_it) {
-        inst = (*inst_it);
+const InstanceBatch & Instances::GetBatch() {
+    return this->batch;
+}
 
-        // ID, total number of items, total cost
-        std::cout << inst->id << space;
-        std::cout << inst->solution.size() << space;
-        std::cout << inst->sum_cost << space;
+/**
+ * Getter of particular instance, which is used for storing solution.
+ */
+Instance * Instances::GetInstance(size_t index) {
+    return this->all_instances.at(index);
+}
 
-        // binary solution
-        for (auto sol_it = inst->solution.begin(); sol_it != inst->solution.end(); ++sol_it)
-            std::cout << space << *sol_it;
+/**
+ * Prints solutions of all instances.
+ */
+void Instances::PrintSolutions(bool binary) {
+    ResultWriter writer(stdout, binary);
 
-        // new line
-        std::cout << std::endl;
-    }
+    for (auto inst_it = this->all_instances.begin(); inst_it != this->all_instances.end(); ++inst_it)
+        writer.Write(*inst_it);
 }
 
 /**
  * Compute heuristic for all instance values and sort them in decreasing order.
  */
 void Instances::ComputeHeuristic() {
-    int len;
     Instance * inst = NULL;
-    std::vector<int>::iterator cost_it;
     int h;
 
-    for (auto inst_it = this->all_instances.begin(); inst_it != this->all_instances.end(); ++inst_it) {
-        inst = *inst_it;
-        len = inst->weight.size();
+    for (size_t i = 0; i < this->batch.Size(); ++i) {
+        InstanceView view = this->batch.View(i);
+        inst = this->all_instances.at(i);
 
-        cost_it = inst->cost.begin();
-        for (auto weight_it= inst->weight.begin(); weight_it < inst->weight.end();  ++weight_it, ++cost_it) {
-            h = (*cost_it) / (*weight_it);
+        for (int j = 0; j < view.size; ++j) {
+            h = view.cost[j] / view.weight[j];
             inst->heuristic.push_back(h);
         }
     }
@@ -140,7 +145,7 @@ std::vector<float> Instances::OrderVector(std::vector<float> const& values) {
 /**
  * Checks if given file exists.
  */
-inline bool Instances::ExistFile(const char * file_name) {
+bool Instances::ExistFile(const char * file_name) {
     std::ifstream ifs(file_name);
 
     if (ifs.good()) {
@@ -153,65 +158,401 @@ inline bool Instances::ExistFile(const char * file_name) {
 }
 
 /**
- * Parses line with space delimiter.
+ * Maps given file to memory and creates instances from its lines.
+ */
+bool Instances::LoadMappedFile(const char * file_name) {
+    int fd = open(file_name, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0)
+        return false;
+
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return false;
+    }
+
+    // empty file does not contain any instance
+    if (st.st_size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void * data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+    const char * begin = static_cast<const char *>(data);
+
+    // binary files are detected by magic number
+    if (static_cast<size_t>(st.st_size) >= sizeof(BinaryHeader) &&
+        memcmp(begin, BINARY_MAGIC, 4) == 0) {
+        if (!LoadBinary(begin, st.st_size))
+            std::cerr << "Given binary file is corrupted!" << std::endl;
+    }
+    else
+        ParseBuffer(begin, begin + st.st_size);
+
+    munmap(data, st.st_size);
+
+    return true;
+}
+
+/**
+ * Creates instances from file in binary columnar format.
+ */
+bool Instances::LoadBinary(const char * begin, size_t size) {
+    BinaryHeader header;
+    memcpy(&header, begin, sizeof(BinaryHeader));
+
+    if (header.version != BINARY_VERSION)
+        return false;
+
+    // all columns have to fit into file, counts are bounded by remaining
+    // size before multiplying so corrupted header cannot overflow
+    uint64_t count = header.count;
+    uint64_t items = header.items;
+    uint64_t available = size - sizeof(BinaryHeader);
+
+    if (available < sizeof(uint64_t))
+        return false;
+
+    available -= sizeof(uint64_t);
+
+    if (count > available / (sizeof(uint64_t) + 3 * sizeof(int32_t)))
+        return false;
+
+    available -= count * (sizeof(uint64_t) + 3 * sizeof(int32_t));
+
+    if (items > available / (2 * sizeof(int32_t)))
+        return false;
+
+    const uint64_t * offsets = reinterpret_cast<const uint64_t *>(begin + sizeof(BinaryHeader));
+    const int32_t * ids = reinterpret_cast<const int32_t *>(offsets + count + 1);
+    const int32_t * capacities = ids + count;
+    const int32_t * volumes = capacities + count;
+    const int32_t * weights = volumes + count;
+    const int32_t * costs = weights + items;
+
+    if (offsets[0] != 0)
+        return false;
+
+    for (uint64_t i = 0; i < count; ++i)
+        if (offsets[i] > offsets[i+1] || offsets[i+1] > items)
+            return false;
+
+    this->batch.Reserve(count, items);
+
+    for (uint64_t i = 0; i < count; ++i) {
+        this->batch.AddInstance(ids[i], volumes[i], capacities[i],
+                                offsets[i+1] - offsets[i],
+                                weights + offsets[i], costs + offsets[i]);
+
+        this->volume = volumes[i];
+        this->capacity = capacities[i];
+        this->max_items = offsets[i+1] - offsets[i];
+    }
+
+    return true;
+}
+
+/**
+ * Stores all instances to file in binary columnar format.
+ */
+bool Instances::WriteBinary(const char * file_name) {
+    std::ofstream file(file_name, std::ios::binary);
+
+    if (!file.good())
+        return false;
+
+    BinaryHeader header;
+    memcpy(header.magic, BINARY_MAGIC, 4);
+    header.version = BINARY_VERSION;
+    header.count = this->batch.Size();
+    header.items = 0;
+
+    // table of offsets, columns of ids, capacities and volumes
+    std::vector<uint64_t> offsets;
+    std::vector<int32_t> ids;
+    std::vector<int32_t> capacities;
+    std::vector<int32_t> volumes;
+    offsets.push_back(0);
+
+    for (size_t i = 0; i < this->batch.Size(); ++i) {
+        InstanceView view = this->batch.View(i);
+
+        header.items += view.size;
+        offsets.push_back(header.items);
+        ids.push_back(view.id);
+        capacities.push_back(view.capacity);
+        volumes.push_back(view.volume);
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(BinaryHeader));
+    file.write(reinterpret_cast<const char *>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char *>(ids.data()), ids.size() * sizeof(int32_t));
+    file.write(reinterpret_cast<const char *>(capacities.data()), capacities.size() * sizeof(int32_t));
+    file.write(reinterpret_cast<const char *>(volumes.data()), volumes.size() * sizeof(int32_t));
+
+    // columns of weights and costs
+    for (size_t i = 0; i < this->batch.Size(); ++i) {
+        InstanceView view = this->batch.View(i);
+        file.write(reinterpret_cast<const char *>(view.weight), view.size * sizeof(int32_t));
+    }
+
+    for (size_t i = 0; i < this->batch.Size(); ++i) {
+        InstanceView view = this->batch.View(i);
+        file.write(reinterpret_cast<const char *>(view.cost), view.size * sizeof(int32_t));
+    }
+
+    return file.good();
+}
+
+/**
+ * Loads instances with given IDs through sidecar index.
+ */
+bool Instances::LoadIndexed(const char * file_name, const std::vector<int> & ids) {
+    InstanceIndex index;
+    IndexEntry entry;
+    std::string line;
+
+    if (!index.Open(file_name))
+        return false;
+
+    int fd = open(file_name, O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    for (auto id : ids) {
+        if (!index.Find(id, &entry)) {
+            std::cerr << "Instance " << id << " does not exist!" << std::endl;
+            continue;
+        }
+
+        line.resize(entry.length);
+
+        if (pread(fd, &line[0], entry.length, entry.offset) != (ssize_t)entry.length) {
+            close(fd);
+            return false;
+        }
+
+        InitializeInstance(line.data(), line.data() + line.size());
+    }
+
+    close(fd);
+
+    return true;
+}
+
+/**
+ * Keeps only instances with given IDs in batch, in the same order as IDs.
+ */
+void Instances::FilterInstances(const std::vector<int> & ids) {
+    std::map<int, size_t> positions;
+    InstanceBatch filtered;
+    InstanceView view;
+
+    // the first occurrence of ID is kept for duplicate IDs
+    for (size_t i = 0; i < this->batch.Size(); ++i)
+        positions.insert(std::make_pair(this->batch.View(i).id, i));
+
+    for (auto id : ids) {
+        auto it = positions.find(id);
+
+        if (it == positions.end()) {
+            std::cerr << "Instance " << id << " does not exist!" << std::endl;
+            continue;
+        }
+
+        view = this->batch.View(it->second);
+        filtered.AddInstance(view.id, view.volume, view.capacity, view.size, view.weight, view.cost);
+    }
+
+    this->batch = filtered;
+}
+
+/**
+ * Reads given file line by line and creates instances.
+ */
+void Instances::LoadStreamFile(const char * file_name) {
+    GzInputStream file(file_name);
+    std::string line;
+
+    while (std::getline(file, line))
+        InitializeInstance(line.data(), line.data() + line.size());
+
+    // instances before damaged block are not solved either
+    if (file.Error() != NULL) {
+        std::cerr << "Given file is corrupted: " << file.Error() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Parses all lines stored in buffer and creates instances. Large buffers are
+ * split into chunks aligned to new lines, which are parsed concurrently to
+ * separate batches and then appended to batch in original order.
+ */
+void Instances::ParseBuffer(const char * begin, const char * end) {
+    size_t size = end - begin;
+    size_t chunks = std::min<size_t>(std::thread::hardware_concurrency(),
+                                     size / PARSE_CHUNK_MIN_SIZE);
+
+    if (chunks < 2) {
+        ParseLines(begin, end, &this->batch);
+    }
+    else {
+        std::vector<const char *> bounds(chunks + 1, end);
+        std::vector<InstanceBatch> parts(chunks);
+        std::vector<std::thread> pool;
+
+        // chunk boundaries are moved behind the nearest new line
+        bounds[0] = begin;
+        for (size_t i = 1; i < chunks; ++i) {
+            const char * p = std::max(bounds[i-1], begin + size * i / chunks);
+            const char * line_end = static_cast<const char *>(memchr(p, '\n', end - p));
+
+            bounds[i] = (line_end == NULL) ? end : line_end + 1;
+        }
+
+        for (size_t i = 0; i < chunks; ++i)
+            pool.push_back(std::thread(ParseLines, bounds[i], bounds[i+1], &parts[i]));
+
+        for (auto & t : pool)
+            t.join();
+
+        for (auto & part : parts)
+            this->batch.Append(part);
+    }
+
+    if (this->batch.Size() > 0) {
+        InstanceView view = this->batch.View(this->batch.Size() - 1);
+        this->volume = view.volume;
+        this->capacity = view.capacity;
+
+        // number of items which can be chosen 
+        this->max_items = view.size;
+    }
+}
+
+/**
+ * Parses all lines stored in buffer and adds instances to given batch.
  */
-std::vector<std::string> * Instances::ParseLine(std::string line) {
-    auto parsed_line = new std::vector<std::string>;
-    std::string delimiter = " ";
-    std::string token;
-    size_t pos = line.find(delimiter);
+void Instances::ParseLines(const char * begin, const char * end, InstanceBatch * batch) {
+    const char * line_end = NULL;
 
-    // workaround which enables to get all words from whole line
-    line = line + delimiter;
+    while (begin < end) {
+        line_end = static_cast<const char *>(memchr(begin, '\n', end - begin));
 
-    // parsing
-    while ((pos = line.find(delimiter)) != std::string::npos) {
-        token = line.substr(0, pos);
-        parsed_line->push_back(token);
-        line.erase(0, pos + delimiter.length());
-    } 
+        if (line_end == NULL)
+            line_end = end;
 
-    return parsed_line;
+        ParseInstance(begin, line_end, batch);
+        begin = line_end + 1;
+    }
+}
+
+/**
+ * Adds new instance from one line to batch and initialized its parameters.
+ */
+void Instances::InitializeInstance(const char * begin, const char * end) {
+    if (!ParseInstance(begin, end, &this->batch))
+        return;
+
+    InstanceView view = this->batch.View(this->batch.Size() - 1);
+    this->volume = view.volume;
+    this->capacity = view.capacity;
+
+    // number of items which can be chosen 
+    this->max_items = view.size;
 }
 
 /**
- * Created new instance and initialized its parameters.
+ * Parses one line with instance and adds it to given batch.
  */
-Instance * Instances::InitializeInstance(std::vector<std::string> * params) {
-    auto instance = new Instance;
+bool Instances::ParseInstance(const char * begin, const char * end, InstanceBatch * batch) {
+    const char * p = begin;
+    int id;
+    int volume = 0;
+    int capacity = 0;
 
     // initializing ID, max number of items, size of knapsack
-    instance->id = TopPopFirst(params);
-    this->volume = TopPopFirst(params);
-    this->capacity = TopPopFirst(params);
+    if (!ParseInt(&p, end, &id))
+        return false;
+
+    ParseInt(&p, end, &volume);
+    ParseInt(&p, end, &capacity);
+
+    batch->BeginInstance(id, volume, capacity);
 
     // initializing weight and cost of items
     int w;
     int c;
-    for (auto it = params->begin() ; it != params->end(); it+=2) {
-       w = atoi((*it).c_str());
-       c = atoi((*(it+1)).c_str());
+    while (ParseInt(&p, end, &w) && ParseInt(&p, end, &c))
+       batch->AddItem(w, c);
 
-       instance->weight.push_back(w);
-       instance->cost.push_back(c);
-    }
-
-    // number of items which can be chosen 
-    this->max_items = instance->weight.size();
+    batch->EndInstance();
 
-    return instance;
+    return true;
 }
 
+/**
+ * Creates instances for all views stored in batch. Only ID is set,
+ * weights and costs are copied later by GetAllInstances.
+ */
+void Instances::CreateInstances() {
+    this->all_instances.reserve(this->batch.Size());
+
+    for (size_t i = 0; i < this->batch.Size(); ++i) {
+        auto instance = new Instance;
+        instance->id = this->batch.View(i).id;
+        instance->sum_cost = 0;
+        instance->upper_bound = -1;
+
+        PushInstance(instance);
+    }
+}
 
 /**
- * Takes the first string value from vector of strings and converts it 
- * to integer. The first string value is then deleted from vector.
+ * Reads integer starting at position p and moves p behind it.
  */
-int Instances::TopPopFirst(std::vector<std::string> * vector) {
-    std::string element = vector->front();
-    vector->erase(vector->begin());
+bool Instances::ParseInt(const char ** p, const char * end, int * value) {
+    const char * it = *p;
+    bool negative = false;
+    int number = 0;
 
-    return atoi(element.c_str());
+    // skip delimiters
+    while (it < end && (*it == ' ' || *it == '\t' || *it == '\r'))
+        ++it;
+
+    if (it == end) {
+        *p = it;
+        return false;
+    }
+
+    if (*it == '-' || *it == '+') {
+        negative = (*it == '-');
+        ++it;
+    }
+
+    while (it < end && *it >= '0' && *it <= '9') {
+        number = number * 10 + (*it - '0');
+        ++it;
+    }
+
+    // skip rest of malformed token, same as atoi would do
+    while (it < end && *it != ' ' && *it != '\t' && *it != '\r')
+        ++it;
+
+    *p = it;
+    *value = negative ? -number : number;
+
+    return true;
 }
 
 /**
@@ -244,3 +585,106 @@ inline void Instances::PushInstance(Instance * inst) {
 }
 
 
+
+/**
+ * Reserves memory for given number of instances and items.
+ */
+void InstanceBatch::Reserve(size_t count, size_t items) {
+    this->id.reserve(count);
+    this->volume.reserve(count);
+    this->capacity.reserve(count);
+    this->offset.reserve(count + 1);
+    this->arena.reserve(2 * items);
+}
+
+/**
+ * Starts new instance.
+ */
+void InstanceBatch::BeginInstance(int id, int volume, int capacity) {
+    this->id.push_back(id);
+    this->volume.push_back(volume);
+    this->capacity.push_back(capacity);
+    this->pending_cost.clear();
+}
+
+/**
+ * Adds item to instance started by BeginInstance. Weights are stored directly
+ * to arena, costs are appended behind them when instance is closed.
+ */
+void InstanceBatch::AddItem(int weight, int cost) {
+    this->arena.push_back(weight);
+    this->pending_cost.push_back(cost);
+}
+
+/**
+ * Closes instance started by BeginInstance.
+ */
+void InstanceBatch::EndInstance() {
+    this->arena.insert(this->arena.end(), this->pending_cost.begin(), this->pending_cost.end());
+    this->offset.push_back(this->arena.size() / 2);
+}
+
+/**
+ * Adds whole instance at once.
+ */
+void InstanceBatch::AddInstance(int id, int volume, int capacity, int size,
+                                const int * weight, const int * cost) {
+    this->id.push_back(id);
+    this->volume.push_back(volume);
+    this->capacity.push_back(capacity);
+
+    this->arena.insert(this->arena.end(), weight, weight + size);
+    this->arena.insert(this->arena.end(), cost, cost + size);
+    this->offset.push_back(this->arena.size() / 2);
+}
+
+/**
+ * Appends all instances of other batch.
+ */
+void InstanceBatch::Append(const InstanceBatch & other) {
+    size_t base = this->arena.size() / 2;
+
+    this->id.insert(this->id.end(), other.id.begin(), other.id.end());
+    this->volume.insert(this->volume.end(), other.volume.begin(), other.volume.end());
+    this->capacity.insert(this->capacity.end(), other.capacity.begin(), other.capacity.end());
+
+    for (size_t i = 1; i < other.offset.size(); ++i)
+        this->offset.push_back(base + other.offset[i]);
+
+    this->arena.insert(this->arena.end(), other.arena.begin(), other.arena.end());
+}
+
+/**
+ * Removes all instances, allocated memory is kept for later use.
+ */
+void InstanceBatch::Clear() {
+    this->id.clear();
+    this->volume.clear();
+    this->capacity.clear();
+    this->offset.resize(1);
+    this->arena.clear();
+}
+
+/**
+ * Getter of number of stored instances.
+ */
+size_t InstanceBatch::Size() const {
+    return this->id.size();
+}
+
+/**
+ * Getter of view of particular instance.
+ */
+InstanceView InstanceBatch::View(size_t index) const {
+    InstanceView view;
+    size_t begin = this->offset[index];
+
+    view.id = this->id[index];
+    view.volume = this->volume[index];
+    view.capacity = this->capacity[index];
+    view.size = this->offset[index + 1] - begin;
+    view.weight = this->arena.data() + 2 * begin;
+    view.cost = view.weight + view.size;
+
+    return view;
+}
@@ -11,10 +11,23 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <numeric>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <fcntl.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "gzip_stream.h"
+#include "index.h"
+#include "result_writer.h"
+#include "solution_bits.h"
 
 /**
  * For branch and bound purposes.
@@ -24,6 +37,8 @@
 //    std::vector<bool> knapsack_distribution;
 //};
 
+#define PARSE_CHUNK_MIN_SIZE  (1 << 22)  // min bytes parsed by one thread
+
 struct Instance {
     int id;                        // ID of instance
     std::vector<int> weight;       // weight of all items
@@ -32,20 +47,145 @@ struct Instance {
 
     // auxiliary variables
     int sum_cost;                  // sum of all item costs 
-    std::vector<bool> solution;    // solution for current items
+    int upper_bound;               // upper bound of optimal cost, -1 if not computed
+    SolutionBits solution;         // solution for current items
     std::vector<float> heuristic;  // computed heuristic value (cost/weight)
 };
 
+/**
+ * Read-only view of one instance stored in InstanceBatch. Solvers can iterate
+ * over views without copying weights and costs.
+ */
+struct InstanceView {
+    int id;                        // ID of instance
+    int volume;                    // max number of items in knapsack
+    int capacity;                  // capacity of knapsack
+    int size;                      // number of items
+    const int * weight;            // weight of all items
+    const int * cost;              // cost of all items
+};
+
+/**
+ * All instances of one file stored as structure of arrays. Weights and costs
+ * of all items are kept in one arena. Instance i owns block of arena starting
+ * at 2*offset[i], the first half of block is column of weights and the second
+ * half is column of costs.
+ */
+class InstanceBatch {
+    public:
+        /**
+         * Reserves memory for given number of instances and items.
+         *
+         * @param  count  number of instances
+         * @param  items  number of items of all instances
+         */
+        void Reserve(size_t count, size_t items);
+
+        /**
+         * Starts new instance. Items are added by AddItem and instance
+         * is closed by EndInstance.
+         *
+         * @param  id        ID of instance
+         * @param  volume    max number of items in knapsack
+         * @param  capacity  capacity of knapsack
+         */
+        void BeginInstance(int id, int volume, int capacity);
+
+        /**
+         * Adds item to instance started by BeginInstance.
+         *
+         * @param  weight  weight of item
+         * @param  cost    cost of item
+         */
+        void AddItem(int weight, int cost);
+
+        /**
+         * Closes instance started by BeginInstance.
+         */
+        void EndInstance();
+
+        /**
+         * Adds whole instance at once.
+         *
+         * @param  id        ID of instance
+         * @param  volume    max number of items in knapsack
+         * @param  capacity  capacity of knapsack
+         * @param  size      number of items
+         * @param  weight    weight of all items
+         * @param  cost      cost of all items
+         */
+        void AddInstance(int id, int volume, int capacity, int size,
+                         const int * weight, const int * cost);
+
+        /**
+         * Appends all instances of other batch.
+         *
+         * @param  other  appended batch
+         */
+        void Append(const InstanceBatch & other);
+
+        /**
+         * Removes all instances, allocated memory is kept for later use.
+         */
+        void Clear();
+
+        /**
+         * Getter of number of stored instances.
+         *
+         * @return  number of instances
+         */
+        size_t Size() const;
+
+        /**
+         * Getter of view of particular instance.
+         *
+         * @param   index  index of instance
+         * @return         view of instance
+         */
+        InstanceView View(size_t index) const;
+
+    private:
+        std::vector<int> id;
+        std::vector<int> volume;
+        std::vector<int> capacity;
+        std::vector<size_t> offset{0};   // offsets of items, Size()+1 values
+        std::vector<int> arena;          // weights and costs of all items
+        std::vector<int> pending_cost;   // costs of instance being built
+};
+
+/**
+ * Binary columnar format of instances.
+ *
+ * File starts with BinaryHeader, which is followed by table of item offsets
+ * (uint64_t, count+1 values) and columns of ids, capacities and volumes
+ * (int32_t, count values each). The end of file is formed by columns of
+ * weights and costs of all items (int32_t, items values each). Items of
+ * instance i are stored between offsets i and i+1.
+ */
+#define BINARY_MAGIC    "KNPB"
+#define BINARY_VERSION  1
+
+struct BinaryHeader {
+    char magic[4];                 // BINARY_MAGIC
+    uint32_t version;              // BINARY_VERSION
+    uint64_t count;                // number of instances
+    uint64_t items;                // number of items of all instances
+};
+
 class Instances {
     public:
         /**
          * Constructor. 
          *
          * Checks if given file name exist, parse lines of that file and creates instances.
+         * If IDs are given, only instances with these IDs are created, in the same
+         * order as IDs. Such instances are found through sidecar index, which is
+         * built when it does not exist or does not match file.
          *
          * @param  file_name  name of file with instances
+         * @param  ids        IDs of instances which are loaded, empty for all
          */
-        Instances(const char * file_name);
+        Instances(const char * file_name, const std::vector<int> & ids = std::vector<int>());
 
         /**
          * Destructor.
@@ -76,16 +216,71 @@ class Instances {
         int GetCapacity();
 
         /**
-         * Getter of all instances needed to be solved.
+         * Getter of all instances needed to be solved. Weights and costs are
+         * copied from batch to instances when called for the first time.
          *
          * @return  all instances
          */
-        std::vector<Instance *> GetAllInstances();
+        const std::vector<Instance *> & GetAllInstances();
+
+        /**
+         * Checks if given file exists.
+         *
+         * @param   file_name  name of file
+         * @return             bool existence of file
+         */
+        static bool ExistFile(const char * file_name);
+
+        /**
+         * Getter of batch with weights and costs of all instances.
+         *
+         * @return  batch of instances
+         */
+        const InstanceBatch & GetBatch();
+
+        /**
+         * Getter of particular instance, which is used for storing solution.
+         *
+         * @param   index  index of instance in batch
+         * @return         pointer to instance
+         */
+        Instance * GetInstance(size_t index);
+
+        /**
+         * Stores all instances to file in binary columnar format.
+         *
+         * @param   file_name  name of output file
+         * @return             false if file could not be written
+         */
+        bool WriteBinary(const char * file_name);
 
         /**
          * Prints solutions of all instances.
+         *
+         * @param  binary  print binary result format instead of text
          */
-        void PrintSolutions();
+        void PrintSolutions(bool binary = false);
+
+        /**
+         * Parses one line with instance and adds it to given batch.
+         * Integers are tokenized in place, without creating any strings.
+         *
+         * @param   begin  pointer to the first character of line
+         * @param   end    pointer behind the last character of line
+         * @param   batch  batch where instance is stored
+         * @return         false for empty line
+         */
+        static bool ParseInstance(const char * begin, const char * end, InstanceBatch * batch);
+
+        /**
+         * Reads integer starting at position p and moves p behind it.
+         *
+         * @param  p      position in line
+         * @param  end    pointer behind the last character of line
+         * @param  value  parsed integer
+         * @return        false if there is no other integer in line
+         */
+        static bool ParseInt(const char ** p, const char * end, int * value);
 
         /**
          * Compute heuristic for all instance values and sort them in decreasing order.
@@ -98,41 +293,82 @@ class Instances {
          * @param  values  vector of float values
          * @return         vector of indexes according to sorted values
          */
-        std::vector<float> OrderVector(std::vector<float> const& values);
+        static std::vector<float> OrderVector(std::vector<float> const& values);
 
     private:
         /**
-         * Checks if given file exists.
+         * Maps given file to memory and creates instances from its lines.
          *
-         * @param   file_name  name of file
-         * @return             bool existence of file
+         * @param   file_name  name of file with instances
+         * @return             false if file could not be mapped
          */
-        inline bool ExistFile(const char * file_name);
+        bool LoadMappedFile(const char * file_name);
 
         /**
-         * Parses line with space delimiter.
+         * Creates instances from file in binary columnar format.
          *
-         * @param  line  string containing words delimited by space character
-         * @return       vector of strings
+         * @param   begin  pointer to the first byte of file
+         * @param   size   size of file
+         * @return         false if file is not valid binary file
+         */
+        bool LoadBinary(const char * begin, size_t size);
+
+        /**
+         * Reads given file line by line and creates instances. Used for gzip
+         * compressed files, which are decompressed on the fly, and for files
+         * which can not be mapped to memory (pipes, special files).
+         *
+         * @param  file_name  name of file with instances
+         */
+        void LoadStreamFile(const char * file_name);
+
+        /**
+         * Parses all lines stored in buffer and creates instances. Large buffers
+         * are parsed concurrently in chunks aligned to new lines.
+         *
+         * @param  begin  pointer to the first character of buffer
+         * @param  end    pointer behind the last character of buffer
+         */
+        void ParseBuffer(const char * begin, const char * end);
+
+        /**
+         * Parses all lines stored in buffer and adds instances to given batch.
+         *
+         * @param  begin  pointer to the first character of buffer
+         * @param  end    pointer behind the last character of buffer
+         * @param  batch  batch where instances are stored
+         */
+        static void ParseLines(const char * begin, const char * end, InstanceBatch * batch);
+
+        /**
+         * Adds new instance from one line to batch and initialized its parameters.
+         *
+         * @param  begin  pointer to the first character of line
+         * @param  end    pointer behind the last character of line
+         */
+        void InitializeInstance(const char * begin, const char * end);
+
+        /**
+         * Creates instances for all views stored in batch. Only ID is set,
+         * weights and costs are copied later by GetAllInstances.
          */
-        std::vector<std::string> * ParseLine(std::string line);
+        void CreateInstances();
 
         /**
-         * Created new instance and initialized its parameters.
+         * Loads instances with given IDs through sidecar index.
          *
-         * @param  params  parameters of instance stored in vector of strings 
-         * @return         pointer to new instance
+         * @param   file_name  name of file with instances
+         * @param   ids        IDs of instances
+         * @return             false if file can not be indexed
          */
-        Instance * InitializeInstance(std::vector<std::string> * params);
+        bool LoadIndexed(const char * file_name, const std::vector<int> & ids);
 
         /**
-         * Takes the first string value from vector of strings and converts it 
-         * to integer. The first string value is then deleted from vector.
+         * Keeps only instances with given IDs in batch, in the same order as IDs.
          *
-         * @param  vector  pointer to string
-         * @return         integer value
+         * @param  ids  IDs of instances
          */
-        int TopPopFirst(std::vector<std::string> * vector);
+        void FilterInstances(const std::vector<int> & ids);
 
         /**
          * Prints information about given Instance * inst.
@@ -150,7 +386,9 @@ class Instances {
         inline void PushInstance(Instance * inst);
 
 
+        InstanceBatch batch;
         std::vector<Instance *> all_instances;
+        bool materialized;  // weights and costs copied to all_instances
         int max_items;  // number of items which can be chosen
         int volume;     // max volume of knapsack 
         int capacity;   // capacity of knapsack
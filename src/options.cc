@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ *
+ * @section DESCRIPTION
+ *
+ * KNAPSACK PROBLEM 
+ *
+ * Parsing of command line options shared by all solvers.
+ */
+
+#include "options.h"
+
+/**
+ * Parses command line options.
+ */
+bool ParseOptions(int argc, char ** argv, int min_param, Options * options) {
+    int opt;
+
+    options->params.clear();
+    options->stream = false;
+    options->binary = false;
+    options->threads = 0;
+    options->ids.clear();
+    options->kernel = NULL;
+
+    while ((opt = getopt(argc, argv, "-sbt:i:k:")) != -1) {
+        switch (opt) {
+            // positional parameter
+            case 1:
+                options->params.push_back(optarg);
+                break;
+
+            case 's':
+                options->stream = true;
+                break;
+
+            case 'b':
+                options->binary = true;
+                break;
+
+            case 't':
+                options->threads = atoi(optarg);
+                break;
+
+            case 'i':
+                ParseIds(optarg, &options->ids);
+                break;
+
+            case 'k':
+                options->kernel = optarg;
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    // the name of program is counted as well
+    return (int)options->params.size() + 1 >= min_param;
+}
+
+/**
+ * Parses comma separated list of IDs.
+ */
+void ParseIds(const char * list, std::vector<int> * ids) {
+    char * end = NULL;
+
+    while (*list != '\0') {
+        // empty field
+        if (*list == ',') {
+            ++list;
+            continue;
+        }
+
+        long id = strtol(list, &end, 10);
+
+        if (end == list || (*end != ',' && *end != '\0')) {
+            std::cerr << "Invalid instance ID in " << list << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        ids->push_back(id);
+        list = end;
+    }
+}
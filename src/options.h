@@ -0,0 +1,59 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ */
+
+#ifndef OPTIONS_HH
+#define OPTIONS_HH
+
+#include <iostream>
+#include <vector>
+
+#include <getopt.h>
+#include <stdlib.h>
+
+/**
+ * Command line options shared by all knapsack solvers.
+ *
+ * -s      stream mode; instances are solved while file is being read
+ * -b      print solutions in binary result format
+ * -t <n>  number of solver threads; in stream mode instances are solved in
+ *         parallel, brute force and parallel kernel of branch and bound
+ *         split also single instances among threads
+ * -i <ids> comma separated IDs of instances which are solved, other
+ *          instances are skipped; instances are found through sidecar index
+ *          (not used in stream mode)
+ * -k <name> solver specific kernel, e.g. algorithm used by brute force
+ */
+struct Options {
+    std::vector<char *> params;  // positional parameters, params[0] is file name
+    bool stream;                 // solve instances in streaming pipeline
+    bool binary;                 // print binary result format
+    int threads;                 // number of solver threads, 0 for all cores
+    std::vector<int> ids;        // IDs of solved instances, empty for all
+    const char * kernel;         // name of solver kernel, NULL for default
+};
+
+/**
+ * Parses command line options. Options can be placed anywhere among
+ * positional parameters.
+ *
+ * @param   argc       number of arguments
+ * @param   argv       arguments
+ * @param   min_param  minimal number of positional parameters including name of program
+ * @param   options    parsed options
+ * @return             false if there is not enough positional parameters
+ */
+bool ParseOptions(int argc, char ** argv, int min_param, Options * options);
+
+/**
+ * Parses comma separated list of IDs. Empty fields are skipped, program
+ * ends if field is not a number.
+ *
+ * @param  list  IDs delimited by comma
+ * @param  ids   parsed IDs are appended here
+ */
+void ParseIds(const char * list, std::vector<int> * ids);
+
+#endif //OPTIONS_HH
@@ -0,0 +1,149 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ *
+ * @section DESCRIPTION
+ *
+ * KNAPSACK PROBLEM 
+ *
+ * Streaming pipeline: reader -> pool of solvers -> ordered writer.
+ */
+
+#include "pipeline.h"
+
+/**
+ * Solves instances from file in three stage pipeline.
+ */
+void SolveStream(const char * file_name, InstanceSolver solver, int threads, bool binary) {
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    BoundedQueue<StreamChunk *> free(STREAM_CHUNKS);
+    BoundedQueue<StreamChunk *> input(STREAM_CHUNKS);
+    BoundedQueue<StreamChunk *> output(STREAM_CHUNKS);
+
+    // chunks are allocated once and recycled by writer
+    std::vector<StreamChunk> chunks(STREAM_CHUNKS);
+    for (auto & chunk : chunks)
+        free.Push(&chunk);
+
+    bool error = false;
+    std::thread reader(ReadChunks, file_name, &free, &input, &error);
+    std::thread writer(WriteChunks, &output, &free, binary);
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i)
+        pool.push_back(std::thread(SolveChunks, solver, &input, &output));
+
+    // reader closes input queue after the last chunk
+    reader.join();
+
+    for (auto & t : pool)
+        t.join();
+
+    output.Close();
+    writer.join();
+
+    if (error)
+        exit(EXIT_FAILURE);
+}
+
+/**
+ * Reader stage. Parses lines of file to free chunks.
+ */
+void ReadChunks(const char * file_name,
+                BoundedQueue<StreamChunk *> * free,
+                BoundedQueue<StreamChunk *> * input,
+                bool * error) {
+    GzInputStream file(file_name);
+    std::string line;
+    StreamChunk * chunk = NULL;
+    size_t sequence = 0;
+
+    while (std::getline(file, line)) {
+        if (chunk == NULL) {
+            free->Pop(&chunk);
+            chunk->sequence = sequence++;
+            chunk->batch.Clear();
+        }
+
+        Instances::ParseInstance(line.data(), line.data() + line.size(), &chunk->batch);
+
+        if (chunk->batch.Size() == STREAM_CHUNK_SIZE) {
+            input->Push(chunk);
+            chunk = NULL;
+        }
+    }
+
+    // the last incomplete chunk
+    if (chunk != NULL)
+        input->Push(chunk);
+
+    if (file.Error() != NULL) {
+        std::cerr << "Given file is corrupted: " << file.Error() << std::endl;
+        *error = true;
+    }
+
+    input->Close();
+}
+
+/**
+ * Solver stage. Solves all instances of parsed chunks.
+ */
+void SolveChunks(InstanceSolver solver,
+                 BoundedQueue<StreamChunk *> * input,
+                 BoundedQueue<StreamChunk *> * output) {
+    StreamChunk * chunk = NULL;
+
+    while (input->Pop(&chunk)) {
+        chunk->results.resize(chunk->batch.Size());
+
+        for (size_t i = 0; i < chunk->batch.Size(); ++i) {
+            InstanceView view = chunk->batch.View(i);
+            Instance * inst = &chunk->results.at(i);
+
+            inst->id = view.id;
+            inst->sum_cost = 0;
+            inst->upper_bound = -1;
+            inst->weight.assign(view.weight, view.weight + view.size);
+            inst->cost.assign(view.cost, view.cost + view.size);
+            inst->appr_cost.clear();
+            inst->heuristic.clear();
+            inst->solution.Clear();
+
+            solver(view, inst);
+        }
+
+        output->Push(chunk);
+    }
+}
+
+/**
+ * Writer stage. Prints solved chunks in original order and returns them
+ * back to reader.
+ */
+void WriteChunks(BoundedQueue<StreamChunk *> * output,
+                 BoundedQueue<StreamChunk *> * free,
+                 bool binary) {
+    ResultWriter writer(stdout, binary);
+    std::map<size_t, StreamChunk *> pending;
+    StreamChunk * chunk = NULL;
+    size_t next = 0;
+
+    while (output->Pop(&chunk)) {
+        pending[chunk->sequence] = chunk;
+
+        // print all chunks which are next in order
+        for (auto it = pending.find(next); it != pending.end(); it = pending.find(next)) {
+            chunk = it->second;
+
+            for (size_t i = 0; i < chunk->batch.Size(); ++i)
+                writer.Write(&chunk->results.at(i));
+
+            pending.erase(it);
+            free->Push(chunk);
+            ++next;
+        }
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ */
+
+#ifndef PIPELINE_HH
+#define PIPELINE_HH
+
+#include <functional>
+#include <map>
+#include <thread>
+
+#include "bounded_queue.h"
+#include "instances.h"
+
+#define STREAM_CHUNK_SIZE   64  // number of instances in one chunk
+#define STREAM_CHUNKS       32  // number of chunks in flight
+
+/**
+ * Solves one instance. Solution and its cost are stored to inst, which has
+ * weights and costs of items filled as well.
+ */
+typedef std::function<void(const InstanceView & view, Instance * inst)> InstanceSolver;
+
+/**
+ * Group of consecutive instances passing through pipeline.
+ */
+struct StreamChunk {
+    size_t sequence;                // order of chunk in input file
+    InstanceBatch batch;            // parsed instances
+    std::vector<Instance> results;  // solved instances
+};
+
+/**
+ * Solves instances from file in three stage pipeline. Reader thread parses
+ * file, pool of solver threads solves instances and writer prints solutions
+ * in the same order as instances are in input file. Stages are connected by
+ * bounded queues and only STREAM_CHUNKS chunks are in flight, therefore memory
+ * does not grow with size of file. Corrupted file ends program with error
+ * after solutions of instances read before damaged block are printed.
+ *
+ * @param  file_name  name of file with instances
+ * @param  solver     function solving one instance
+ * @param  threads    number of solver threads, 0 for all cores
+ * @param  binary     print binary result format instead of text
+ */
+void SolveStream(const char * file_name, InstanceSolver solver, int threads, bool binary);
+
+/**
+ * Reader stage. Parses lines of file to free chunks.
+ *
+ * @param  file_name  name of file with instances
+ * @param  free       chunks available for filling
+ * @param  input      parsed chunks
+ * @param  error      set to true if file is corrupted
+ */
+void ReadChunks(const char * file_name,
+                BoundedQueue<StreamChunk *> * free,
+                BoundedQueue<StreamChunk *> * input,
+                bool * error);
+
+/**
+ * Solver stage. Solves all instances of parsed chunks.
+ *
+ * @param  solver  function solving one instance
+ * @param  input   parsed chunks
+ * @param  output  solved chunks
+ */
+void SolveChunks(InstanceSolver solver,
+                 BoundedQueue<StreamChunk *> * input,
+                 BoundedQueue<StreamChunk *> * output);
+
+/**
+ * Writer stage. Prints solved chunks in original order and returns them
+ * back to reader.
+ *
+ * @param  output  solved chunks
+ * @param  free    chunks available for filling
+ * @param  binary  print binary result format instead of text
+ */
+void WriteChunks(BoundedQueue<StreamChunk *> * output,
+                 BoundedQueue<StreamChunk *> * free,
+                 bool binary);
+
+#endif //PIPELINE_HH
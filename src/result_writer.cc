@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ *
+ * @section DESCRIPTION
+ *
+ * KNAPSACK PROBLEM 
+ *
+ * Buffered writing of solutions in text or binary format.
+ */
+
+#include "result_writer.h"
+#include "instances.h"
+
+/**
+ * Constructor.
+ */
+ResultWriter::ResultWriter(FILE * file, bool binary) 
+    : file(file), binary(binary), header_written(false), buffer(RESULT_BUFFER_SIZE), used(0) {}
+
+/**
+ * Destructor.
+ *
+ * Flushes buffered solutions.
+ */
+ResultWriter::~ResultWriter() {
+    Flush();
+}
+
+/**
+ * Writes solution of one instance.
+ */
+void ResultWriter::Write(const Instance * inst) {
+    if (this->binary)
+        WriteBinary(inst);
+    else
+        WriteText(inst);
+}
+
+/**
+ * Writes all buffered solutions to file.
+ */
+void ResultWriter::Flush() {
+    if (this->used > 0)
+        fwrite(this->buffer.data(), 1, this->used, this->file);
+
+    fflush(this->file);
+    this->used = 0;
+}
+
+/**
+ * Writes solution in text format, same as *.sol.dat files.
+ */
+void ResultWriter::WriteText(const Instance * inst) {
+    size_t size = inst->solution.Size();
+
+    // digits of three integers, spaces, solution and new line
+    Reserve(3 * 21 + 4 + 2 * size);
+
+    // ID, total number of items, total cost
+    PutInt(inst->id);
+    this->buffer[this->used++] = ' ';
+    PutInt(size);
+    this->buffer[this->used++] = ' ';
+    PutInt(inst->sum_cost);
+    this->buffer[this->used++] = ' ';
+
+    // binary solution
+    char * out = this->buffer.data() + this->used;
+    for (size_t i = 0; i < size; ++i) {
+        *out++ = ' ';
+        *out++ = inst->solution.Get(i) ? '1' : '0';
+    }
+
+    *out++ = '\n';
+    this->used = out - this->buffer.data();
+}
+
+/**
+ * Writes solution in binary format.
+ */
+void ResultWriter::WriteBinary(const Instance * inst) {
+    size_t size = inst->solution.Size();
+    size_t bytes = (size + 7) / 8;
+
+    if (!this->header_written) {
+        ResultHeader header;
+        memcpy(header.magic, RESULT_MAGIC, 4);
+        header.version = RESULT_VERSION;
+
+        Reserve(sizeof(ResultHeader));
+        memcpy(this->buffer.data() + this->used, &header, sizeof(ResultHeader));
+        this->used += sizeof(ResultHeader);
+        this->header_written = true;
+    }
+
+    Reserve(3 * sizeof(int32_t) + bytes);
+
+    int32_t fields[3] = {inst->id, (int32_t)size, inst->sum_cost};
+    memcpy(this->buffer.data() + this->used, fields, sizeof(fields));
+    this->used += sizeof(fields);
+
+    // packed solution, bytes of little endian words are already in file order
+    unsigned char * out = reinterpret_cast<unsigned char *>(this->buffer.data() + this->used);
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    memcpy(out, inst->solution.Words(), bytes);
+#else
+    memset(out, 0, bytes);
+
+    for (size_t i = 0; i < size; ++i)
+        if (inst->solution.Get(i))
+            out[i / 8] |= 1 << (i % 8);
+#endif
+
+    this->used += bytes;
+}
+
+/**
+ * Makes sure that there is space for given number of bytes in buffer.
+ */
+inline void ResultWriter::Reserve(size_t size) {
+    if (this->used + size > this->buffer.size()) {
+        Flush();
+
+        if (size > this->buffer.size())
+            this->buffer.resize(size);
+    }
+}
+
+/**
+ * Appends decimal representation of integer to buffer.
+ */
+inline void ResultWriter::PutInt(long value) {
+    char digits[24];
+    int length = 0;
+    unsigned long number = (value < 0) ? -(unsigned long)value : value;
+
+    do {
+        digits[length++] = '0' + number % 10;
+        number /= 10;
+    } while (number > 0);
+
+    if (value < 0)
+        this->buffer[this->used++] = '-';
+
+    while (length > 0)
+        this->buffer[this->used++] = digits[--length];
+}
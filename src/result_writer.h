@@ -0,0 +1,102 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ */
+
+#ifndef RESULT_WRITER_HH
+#define RESULT_WRITER_HH
+
+#include <vector>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+struct Instance;
+
+#define RESULT_BUFFER_SIZE  (1 << 16)
+
+/**
+ * Binary result format.
+ *
+ * File starts with ResultHeader. Every solution is then stored as three
+ * int32_t values (ID, number of items, total cost) followed by bits of
+ * solution packed to (number of items + 7) / 8 bytes, the first item
+ * is the least significant bit of the first byte.
+ */
+#define RESULT_MAGIC    "KNPS"
+#define RESULT_VERSION  1
+
+struct ResultHeader {
+    char magic[4];                 // RESULT_MAGIC
+    uint32_t version;              // RESULT_VERSION
+};
+
+class ResultWriter {
+    public:
+        /**
+         * Constructor.
+         *
+         * @param  file    output file
+         * @param  binary  write binary result format instead of text (*.sol.dat)
+         */
+        ResultWriter(FILE * file, bool binary);
+
+        /**
+         * Destructor.
+         *
+         * Flushes buffered solutions.
+         */
+        ~ResultWriter();
+
+        /**
+         * Writes solution of one instance.
+         *
+         * @param  inst  solved instance
+         */
+        void Write(const Instance * inst);
+
+        /**
+         * Writes all buffered solutions to file.
+         */
+        void Flush();
+
+    private:
+        /**
+         * Writes solution in text format, same as *.sol.dat files.
+         *
+         * @param  inst  solved instance
+         */
+        void WriteText(const Instance * inst);
+
+        /**
+         * Writes solution in binary format.
+         *
+         * @param  inst  solved instance
+         */
+        void WriteBinary(const Instance * inst);
+
+        /**
+         * Makes sure that there is space for given number of bytes in buffer.
+         *
+         * @param  size  number of bytes
+         */
+        inline void Reserve(size_t size);
+
+        /**
+         * Appends decimal representation of integer to buffer.
+         *
+         * @param  value  integer value
+         */
+        inline void PutInt(long value);
+
+        FILE * file;
+        bool binary;
+        bool header_written;
+
+        std::vector<char> buffer;
+        size_t used;
+};
+
+#endif //RESULT_WRITER_HH
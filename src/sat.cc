@@ -12,19 +12,19 @@
 #include "sat.h"
 
 /**
- * Constructor reads CNF in DIMACS format.
+ * Constructor reads CNF in DIMACS format. Gzip compressed files are
+ * decompressed on the fly.
  */
-SatInstance::SatInstance(const char * fileName) {
-    std::vector<std::string> * params = NULL;
-    SatInstance * inst = NULL;
+SatInstance::SatInstance(const char * fileName) 
+    : top(0), length(0), numberClauses(0), weighted(false) {
 
     if (ExistFile(fileName)) {
-        std::ifstream file(fileName);
-        std::string line; 
+        LoadFile(fileName);
+
+        // variables without weights
+        if ((int)this->weights.size() < this->length)
+            this->weights.resize(this->length, 1);
 
-        ReadHead(file);
-        this->weights = ReadWeights(file);
-        this->formula = ReadBooleanFormula(file);
         this->length = weights.size();
 
         // sums weights of suboptimal solution given by input file
@@ -57,88 +57,246 @@ inline bool SatInstance::ExistFile(const char * fileName) {
     }   
 }
 
-/** 
- * Skips first four rows containing head.
- * The second row is consisted from suboptimal solution,
- * which is recorded for later purpose.
+/**
+ * Maps file to memory and parses it. Gzip compressed files and files which
+ * can not be mapped are read to memory first.
  */
-void SatInstance::ReadHead(std::ifstream & file) {
-    std::string line;
-    std::vector<bool> suboptimalSolution;
+void SatInstance::LoadFile(const char * fileName) {
+    struct stat st;
+    int fd = open(fileName, O_RDONLY);
+
+    if (!IsGzipFile(fileName) && fd >= 0 && fstat(fd, &st) == 0 && 
+        S_ISREG(st.st_mode) && st.st_size > 0) {
+        void * data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
 
-    for (int i = 0; i < 4; ++i) {
-       std::getline(file, line);
+        if (data != MAP_FAILED) {
+            close(fd);
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
 
-       if (i == 1) {
-        suboptimalSolution = ReadSuboptimalSolution(line);
-        SetSuboptimalSolution(suboptimalSolution);
+            const char * begin = static_cast<const char *>(data);
+            ParseDimacs(begin, begin + st.st_size);
+
+            munmap(data, st.st_size);
+            return;
         }
     }
+
+    if (fd >= 0)
+        close(fd);
+
+    GzInputStream file(fileName);
+    std::string content((std::istreambuf_iterator<char>(file)), 
+                        std::istreambuf_iterator<char>());
+
+    if (file.Error() != NULL) {
+        std::cerr << "Given file is corrupted: " << file.Error() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    ParseDimacs(content.data(), content.data() + content.size());
 }
 
-std::vector<int> SatInstance::ReadWeights(std::ifstream & file) {
-    std::string line;
-    std::getline(file, line);
+/**
+ * Parses whole file in single pass.
+ */
+void SatInstance::ParseDimacs(const char * begin, const char * end) {
+    const char * p = begin;
+    bool clauseWeightRead = false;
+    int literal;
+
+    while (p < end) {
+        // skip white characters
+        if (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+            ++p;
+            continue;
+        }
+
+        switch (*p) {
+            case 'c':
+                p = ParseComment(p, end);
+                break;
+
+            case 'p':
+                p = ParseProblem(p, end);
+                this->formula.Reserve(this->numberClauses);
+                break;
+
+            case 'w':
+                p = ParseWeights(p, end);
+                break;
+
+            // end of formula in SATLIB files
+            case '%':
+                p = end;
+                break;
+
+            default:
+                if (!ParseInt(&p, end, &literal)) {
+                    std::cerr << "Invalid DIMACS format!" << std::endl;
+                    exit(INVALID_FORMAT);
+                }
+
+                // the first number of weighted clause is its weight
+                if (this->weighted && !clauseWeightRead) {
+                    this->clauseWeights.push_back(literal);
+                    clauseWeightRead = true;
+                }
+                else if (literal == 0) {
+                    this->formula.EndClause();
+                    clauseWeightRead = false;
+                }
+                else {
+                    this->formula.AddLiteral(literal);
+                    this->length = std::max(this->length, std::abs(literal));
+                }
+        }
+    }
 
-    return ParseWeights(line);
+    // the last clause without terminating zero
+    if (!this->formula.EmptyClause())
+        this->formula.EndClause();
+
+    if (this->weighted && (int)this->clauseWeights.size() > this->formula.Size())
+        this->clauseWeights.resize(this->formula.Size());
+
+    this->formula.BuildOccurrences(this->length);
 }
 
-std::vector<int> SatInstance::ParseWeights(std::string & line) {
-    std::vector<int> parsedWeights;
-    std::string delimiter = " ";
-    std::string token;
+/**
+ * Parses comment line. Comment in format
+ * c solution = 110011110010100
+ * contains suboptimal solution.
+ */
+const char * SatInstance::ParseComment(const char * p, const char * end) {
+    const char * lineEnd = SkipLine(p, end);
+    const char * solution = "solution";
+    size_t solutionLength = strlen(solution);
+
+    // skip "c" and white characters
+    ++p;
+    while (p < lineEnd && (*p == ' ' || *p == '\t'))
+        ++p;
 
-    // delete the name of line
-    size_t pos = line.find(delimiter);
-    assert(line.substr(0, pos) == "w");
-    line.erase(0, pos + delimiter.length());
+    if ((size_t)(lineEnd - p) > solutionLength && strncmp(p, solution, solutionLength) == 0) {
+        const char * eq = static_cast<const char *>(memchr(p, '=', lineEnd - p));
 
-    // workaround which enables to get all words from whole line
-    line = line + delimiter;
+        if (eq != NULL) {
+            SolutionBits suboptimalSolution;
 
-    // parsing
-    while ((pos = line.find(delimiter)) != std::string::npos) {
-        token = line.substr(0, pos);
-        parsedWeights.push_back(std::stoi(token));
-        line.erase(0, pos + delimiter.length());
-    } 
+            for (p = eq + 1; p < lineEnd; ++p)
+                if (*p == '0' || *p == '1')
+                    suboptimalSolution.PushBack(CharToBool(*p));
+
+            SetSuboptimalSolution(suboptimalSolution);
+        }
+    }
+
+    return lineEnd;
+}
+
+/**
+ * Parses problem line
+ * p cnf <vars> <clauses>
+ * p wcnf <vars> <clauses> [<top>]
+ */
+const char * SatInstance::ParseProblem(const char * p, const char * end) {
+    const char * lineEnd = SkipLine(p, end);
+    int vars = 0;
+
+    // skip "p" and white characters
+    ++p;
+    while (p < lineEnd && (*p == ' ' || *p == '\t'))
+        ++p;
+
+    if (lineEnd - p >= 4 && strncmp(p, "wcnf", 4) == 0) {
+        this->weighted = true;
+        p += 4;
+    }
+    else if (lineEnd - p >= 3 && strncmp(p, "cnf", 3) == 0) {
+        p += 3;
+    }
+    else {
+        std::cerr << "Invalid DIMACS format!" << std::endl;
+        exit(INVALID_FORMAT);
+    }
 
-    return parsedWeights;
+    ParseInt(&p, lineEnd, &vars);
+    ParseInt(&p, lineEnd, &this->numberClauses);
+
+    if (this->weighted)
+        ParseInt(&p, lineEnd, &this->top);
+
+    this->length = std::max(this->length, vars);
+
+    return lineEnd;
 }
 
-BooleanFormula SatInstance::ReadBooleanFormula(std::ifstream & file) {
-   BooleanFormula bf;
-   std::string line;
-   Clause c;
+/**
+ * Parses line with weights of variables
+ * w <w1> <w2> ...
+ */
+const char * SatInstance::ParseWeights(const char * p, const char * end) {
+    const char * lineEnd = SkipLine(p, end);
+    int w;
+
+    // skip "w"
+    ++p;
 
-   while (std::getline(file, line)) {
-       c = ParseClause(line);
-       bf.push_back(c);
-   }
+    this->weights.clear();
+    while (ParseInt(&p, lineEnd, &w))
+        this->weights.push_back(w);
 
-   return bf;
+    return lineEnd;
 }
 
-Clause SatInstance::ParseClause(std::string &line) {
-    std::vector<int> parsedClause;
-    std::string delimiter = " ";
-    std::string token;
-    size_t pos;
-
-    // parsing
-    while ((pos = line.find(delimiter)) != std::string::npos) {
-        token = line.substr(0, pos);
-        parsedClause.push_back(std::stoi(token));
-        line.erase(0, pos + delimiter.length());
-    } 
+/**
+ * Reads integer starting at position p and moves p behind it.
+ * Returns false if there is no integer before end.
+ */
+bool SatInstance::ParseInt(const char ** p, const char * end, int * value) {
+    const char * it = *p;
+    bool negative = false;
+    int number = 0;
+
+    while (it < end && (*it == ' ' || *it == '\t' || *it == '\r' || *it == '\n'))
+        ++it;
+
+    if (it < end && (*it == '-' || *it == '+')) {
+        negative = (*it == '-');
+        ++it;
+    }
 
-    return parsedClause;
+    if (it == end || *it < '0' || *it > '9') {
+        *p = it;
+        return false;
+    }
+
+    while (it < end && *it >= '0' && *it <= '9') {
+        number = number * 10 + (*it - '0');
+        ++it;
+    }
+
+    *p = it;
+    *value = negative ? -number : number;
+
+    return true;
+}
+
+/**
+ * Returns pointer to the end of line starting at p.
+ */
+const char * SatInstance::SkipLine(const char * p, const char * end) {
+    const char * lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+
+    return (lineEnd == NULL) ? end : lineEnd;
 }
 
 void SatInstance::PrintFormula() {
-    for (auto i : this->formula) {
-        for (auto j : i)
-            std::cout << j << " ";
+    for (int i = 0; i < this->formula.Size(); ++i) {
+        ClauseView c = this->formula.Clause(i);
+
+        for (const int * j = c.begin; j != c.end; ++j)
+            std::cout << *j << " ";
 
         std::cout << std::endl;
     }
@@ -155,40 +313,6 @@ int SatInstance::GetLength() {
     return this->length;
 }
 
-/**
- * Read line containing suboptimal solution given in format:
- * c solution = 110011110010100
- */
-std::vector<bool> SatInstance::ReadSuboptimalSolution(std::string & line) {
-    std::string delimiter = " ";
-    std::string token;
-
-    // delete the name of line
-    size_t pos = line.find(delimiter);
-    assert(line.substr(0, pos) == "c");
-    line.erase(0, pos + delimiter.length());
-
-    // parsing
-    while ((pos = line.find(delimiter)) != std::string::npos) {
-        token = line.substr(0, pos);
-        line.erase(0, pos + delimiter.length());
-    } 
-
-    return ParseBinaryVector(line);
-}
-
-/** 
- * Parse a string containing binary vector.
- */
-std::vector<bool> SatInstance::ParseBinaryVector(std::string & line) {
-    std::vector<bool> binaryVector;
-
-    for(char c : line)
-        binaryVector.push_back(CharToBool(c));
-
-    return binaryVector;
-}
-
 /**
  * Char to bool conversion.
  */
@@ -202,7 +326,7 @@ bool SatInstance::CharToBool(char c) {
 /**
  * Setter of private variable suboptimalSolution.
  */
-void SatInstance::SetSuboptimalSolution(std::vector<bool> & suboptimalSolution) {
+void SatInstance::SetSuboptimalSolution(SolutionBits & suboptimalSolution) {
     this->suboptimalSolution = suboptimalSolution;
 }
 
@@ -212,12 +336,9 @@ void SatInstance::SetSuboptimalSolution(std::vector<bool> & suboptimalSolution)
 void SatInstance::SumSuboptimalWeights() {
     int weightSum = 0;
 
-    auto w_it = this->weights.begin();
-    for (auto b : this->suboptimalSolution) {
-        if (b == 1)
-            weightSum += *w_it;
-
-        w_it++;
+    for (size_t i = 0; i < this->suboptimalSolution.Size(); ++i) {
+        if (this->suboptimalSolution.Get(i))
+            weightSum += this->weights[i];
     }
 
     this->suboptimalWeightSum = weightSum;
@@ -226,7 +347,7 @@ void SatInstance::SumSuboptimalWeights() {
 /**
  * Getter of private variable suboptimalSolution.
  */
-std::vector<bool> SatInstance::GetSuboptimalSolution() {
+SolutionBits SatInstance::GetSuboptimalSolution() {
     return this->suboptimalSolution;
 }
 
@@ -261,4 +382,118 @@ int SatInstance::GetMaxWeightSum() {
  */
 int SatInstance::SetMaxWeightSum(int maxWeightSum) {
     this->maxWeightSum = maxWeightSum;
+
+    return this->maxWeightSum;
+}
+
+/**
+ * Reserves memory for given number of clauses.
+ */
+void ClauseStore::Reserve(int clauses) {
+    this->clauseOffsets.reserve(clauses + 1);
+}
+
+/**
+ * Adds literal to clause being built.
+ */
+void ClauseStore::AddLiteral(int literal) {
+    this->literals.push_back(literal);
+}
+
+/**
+ * Closes clause being built.
+ */
+void ClauseStore::EndClause() {
+    this->clauseOffsets.push_back(this->literals.size());
+}
+
+/**
+ * Returns true if clause being built has no literals.
+ */
+bool ClauseStore::EmptyClause() const {
+    return (int)this->literals.size() == this->clauseOffsets.back();
+}
+
+/**
+ * Builds occurrence lists of all variables. Lists are filled by counting
+ * sort, so clauses in every list are in increasing order.
+ */
+void ClauseStore::BuildOccurrences(int numberVariables) {
+    // literals out of declared range still get their lists
+    for (auto literal : this->literals)
+        numberVariables = std::max(numberVariables, std::abs(literal));
+
+    this->positiveOffsets.assign(numberVariables + 2, 0);
+    this->negativeOffsets.assign(numberVariables + 2, 0);
+
+    // count occurrences
+    for (auto literal : this->literals) {
+        if (literal > 0)
+            this->positiveOffsets[literal + 1]++;
+        else
+            this->negativeOffsets[-literal + 1]++;
+    }
+
+    for (int v = 1; v <= numberVariables; ++v) {
+        this->positiveOffsets[v + 1] += this->positiveOffsets[v];
+        this->negativeOffsets[v + 1] += this->negativeOffsets[v];
+    }
+
+    this->positiveClauses.resize(this->positiveOffsets.back());
+    this->negativeClauses.resize(this->negativeOffsets.back());
+
+    // fill lists
+    std::vector<int> positiveNext(this->positiveOffsets.begin(), this->positiveOffsets.end() - 1);
+    std::vector<int> negativeNext(this->negativeOffsets.begin(), this->negativeOffsets.end() - 1);
+
+    for (int i = 0; i < Size(); ++i) {
+        for (int j = this->clauseOffsets[i]; j < this->clauseOffsets[i + 1]; ++j) {
+            int literal = this->literals[j];
+
+            if (literal > 0)
+                this->positiveClauses[positiveNext[literal]++] = i;
+            else
+                this->negativeClauses[negativeNext[-literal]++] = i;
+        }
+    }
+}
+
+/**
+ * Number of clauses.
+ */
+int ClauseStore::Size() const {
+    return this->clauseOffsets.size() - 1;
+}
+
+/**
+ * Literals of clause i.
+ */
+ClauseView ClauseStore::Clause(int i) const {
+    ClauseView view;
+    view.begin = this->literals.data() + this->clauseOffsets[i];
+    view.end = this->literals.data() + this->clauseOffsets[i + 1];
+
+    return view;
+}
+
+/**
+ * Clauses containing positive literal of variable (1-based).
+ */
+ClauseView ClauseStore::Positive(int variable) const {
+    ClauseView view;
+    view.begin = this->positiveClauses.data() + this->positiveOffsets[variable];
+    view.end = this->positiveClauses.data() + this->positiveOffsets[variable + 1];
+
+    return view;
+}
+
+/**
+ * Clauses containing negative literal of variable (1-based).
+ */
+ClauseView ClauseStore::Negative(int variable) const {
+    ClauseView view;
+    view.begin = this->negativeClauses.data() + this->negativeOffsets[variable];
+    view.end = this->negativeClauses.data() + this->negativeOffsets[variable + 1];
+
+    return view;
 }
@@ -8,6 +8,7 @@
 #define SAT_HH
 
 #include <algorithm>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -15,13 +16,100 @@
 #include <vector>
 
 #include <assert.h>
+#include <fcntl.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-typedef std::vector<int> Clause;
-typedef std::vector<Clause> BooleanFormula;
+#include "gzip_stream.h"
+#include "solution_bits.h"
+
+/**
+ * Read-only view of consecutive integers stored in ClauseStore; literals
+ * of one clause or indexes of clauses containing one variable.
+ */
+struct ClauseView {
+    const int * begin;
+    const int * end;
+
+    int size() const { return end - begin; }
+};
+
+/**
+ * Boolean formula in compressed sparse row layout. Literals of all clauses
+ * are stored in one array, clause i owns literals between clauseOffsets[i]
+ * and clauseOffsets[i+1]. Occurrence lists are stored the same way, for
+ * every variable there is list of clauses where it appears as positive and
+ * negative literal.
+ */
+class ClauseStore {
+    public:
+        /**
+         * Reserves memory for given number of clauses.
+         */
+        void Reserve(int clauses);
+
+        /**
+         * Adds literal to clause being built.
+         */
+        void AddLiteral(int literal);
+
+        /**
+         * Closes clause being built.
+         */
+        void EndClause();
+
+        /**
+         * Returns true if clause being built has no literals.
+         */
+        bool EmptyClause() const;
+
+        /**
+         * Builds occurrence lists of all variables.
+         *
+         * @param  numberVariables  number of variables
+         */
+        void BuildOccurrences(int numberVariables);
+
+        /** Number of clauses. */
+        int Size() const;
+
+        /** Literals of clause i. */
+        ClauseView Clause(int i) const;
+
+        /** Clauses containing positive literal of variable (1-based). */
+        ClauseView Positive(int variable) const;
+
+        /** Clauses containing negative literal of variable (1-based). */
+        ClauseView Negative(int variable) const;
+
+    private:
+        std::vector<int> literals;
+        std::vector<int> clauseOffsets{0};
+
+        std::vector<int> positiveOffsets;
+        std::vector<int> positiveClauses;
+        std::vector<int> negativeOffsets;
+        std::vector<int> negativeClauses;
+};
 
 const int FILE_NOT_EXIST = 1;
+const int INVALID_FORMAT = 2;
 
+/**
+ * Instance of weighted SAT problem loaded from file in DIMACS format.
+ *
+ * Supported lines:
+ *   c ...                    comment, "c solution = 0110" stores suboptimal solution
+ *   p cnf <vars> <clauses>   header of CNF
+ *   p wcnf <vars> <clauses> [<top>]
+ *                            header of weighted CNF, every clause starts with its weight
+ *   w <w1> <w2> ...          weights of variables
+ *   %                        end of formula (SATLIB)
+ * Clauses are terminated by 0 and they can span several lines.
+ */
 class SatInstance {
     public:
         SatInstance(const char * file_name);
@@ -30,31 +118,35 @@ class SatInstance {
         void PrintWeights();
         int GetLength();
 
-        std::vector<bool> GetSuboptimalSolution();
+        SolutionBits GetSuboptimalSolution();
         int GetSuboptimalWeightSum();
         int SetMaxWeightSum(int maxWeightSum);
         int GetMaxWeightSum();
 
-        std::vector<int> weights;
-        BooleanFormula formula;
+        std::vector<int> weights;        // weights of variables
+        ClauseStore formula;
+        std::vector<int> clauseWeights;  // weights of clauses, only for wcnf
+        int top;                         // weight of hard clauses, only for wcnf
 
     private:
         inline bool ExistFile(const char * file_name);
-        void ReadHead(std::ifstream & file);
-        std::vector<int> ReadWeights(std::ifstream & file);
-        BooleanFormula ReadBooleanFormula(std::ifstream & file);
-        std::vector<int> ParseWeights(std::string & line);
-        Clause ParseClause(std::string &line);
-        std::vector<bool> ReadSuboptimalSolution(std::string & line);
-        std::vector<bool> ParseBinaryVector(std::string & line);
+        void LoadFile(const char * fileName);
+        void ParseDimacs(const char * begin, const char * end);
+        const char * ParseComment(const char * p, const char * end);
+        const char * ParseProblem(const char * p, const char * end);
+        const char * ParseWeights(const char * p, const char * end);
+        static bool ParseInt(const char ** p, const char * end, int * value);
+        static const char * SkipLine(const char * p, const char * end);
         bool CharToBool(char c);
-        void SetSuboptimalSolution(std::vector<bool> & suboptimalSolution);
+        void SetSuboptimalSolution(SolutionBits & suboptimalSolution);
         void SumSuboptimalWeights();
         void SumMaxWeights();
 
         int length; // length of solutions; number of variables
+        int numberClauses; // number of clauses declared in header
+        bool weighted; // clauses are weighted (wcnf)
 
-        std::vector<bool> suboptimalSolution; // given solution read from file
+        SolutionBits suboptimalSolution; // given solution read from file
         int suboptimalWeightSum;
 
         int maxWeightSum;
@@ -0,0 +1,246 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ */
+
+#ifndef SOLUTION_BITS_HH
+#define SOLUTION_BITS_HH
+
+#include <functional>
+#include <vector>
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SOLUTION_BITS_AVX2
+#include <immintrin.h>
+#endif
+
+#define SOLUTION_WORD_BITS 64
+
+/**
+ * Binary solution packed to 64 bit words, bit i of word i/64 belongs to
+ * item (or variable) i. Bits behind the last one are always zero, so
+ * solutions are compared and hashed word by word.
+ */
+class SolutionBits {
+    public:
+        SolutionBits() : size(0) {}
+
+        /**
+         * Constructor.
+         *
+         * @param  size   number of bits
+         * @param  value  initial value of all bits
+         */
+        explicit SolutionBits(size_t size, bool value = false)
+            : size(size), words((size + SOLUTION_WORD_BITS - 1) / SOLUTION_WORD_BITS, value ? ~(uint64_t)0 : 0) {
+            ClearTail();
+        }
+
+        /**
+         * Creates solution of at most 64 bits from mask.
+         *
+         * @param   mask  bit i of mask is bit i of solution
+         * @param   size  number of bits
+         * @return        created solution
+         */
+        static SolutionBits FromMask(uint64_t mask, size_t size) {
+            SolutionBits bits(size);
+
+            if (size > 0) {
+                bits.words[0] = mask;
+                bits.ClearTail();
+            }
+
+            return bits;
+        }
+
+        /** Number of bits. */
+        size_t Size() const { return this->size; }
+
+        /** True if there are no bits. */
+        bool Empty() const { return this->size == 0; }
+
+        /** Value of bit i. */
+        bool Get(size_t i) const {
+            return (this->words[i / SOLUTION_WORD_BITS] >> (i % SOLUTION_WORD_BITS)) & 1;
+        }
+
+        /** Sets value of bit i. */
+        void Set(size_t i, bool value) {
+            uint64_t bit = (uint64_t)1 << (i % SOLUTION_WORD_BITS);
+
+            if (value)
+                this->words[i / SOLUTION_WORD_BITS] |= bit;
+            else
+                this->words[i / SOLUTION_WORD_BITS] &= ~bit;
+        }
+
+        /** Flips value of bit i. */
+        void Flip(size_t i) {
+            this->words[i / SOLUTION_WORD_BITS] ^= (uint64_t)1 << (i % SOLUTION_WORD_BITS);
+        }
+
+        /** Appends bit behind the last one. */
+        void PushBack(bool value) {
+            if (this->size % SOLUTION_WORD_BITS == 0)
+                this->words.push_back(0);
+
+            Set(this->size++, value);
+        }
+
+        /** Removes the last bit. */
+        void PopBack() {
+            Set(--this->size, false);
+
+            if (this->size % SOLUTION_WORD_BITS == 0)
+                this->words.pop_back();
+        }
+
+        /** Changes number of bits, added bits are zero. */
+        void Resize(size_t size) {
+            this->size = size;
+            this->words.resize((size + SOLUTION_WORD_BITS - 1) / SOLUTION_WORD_BITS, 0);
+            ClearTail();
+        }
+
+        /** Removes all bits. */
+        void Clear() {
+            this->size = 0;
+            this->words.clear();
+        }
+
+        /** Number of set bits. */
+        int Count() const {
+            int count = 0;
+
+            for (auto w : this->words)
+                count += __builtin_popcountll(w);
+
+            return count;
+        }
+
+        /** Packed words. */
+        const uint64_t * Words() const { return this->words.data(); }
+
+        /** Packed words, bits behind the last one have to stay zero. */
+        uint64_t * Words() { return this->words.data(); }
+
+        /** Number of packed words. */
+        size_t WordCount() const { return this->words.size(); }
+
+        bool operator==(const SolutionBits & other) const {
+            return this->size == other.size && this->words == other.words;
+        }
+
+        bool operator!=(const SolutionBits & other) const {
+            return !(*this == other);
+        }
+
+        /** Hash of all words. */
+        size_t Hash() const {
+            uint64_t hash = this->size * 0x9e3779b97f4a7c15ULL;
+
+            for (auto w : this->words) {
+                hash ^= w + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+            }
+
+            return hash;
+        }
+
+        /**
+         * Sums values of set bits, e.g. cost or weight of selected items.
+         *
+         * @param   values  array with at least Size() values
+         * @return          sum of values[i] for all set bits i
+         */
+        long long Dot(const int * values) const {
+#ifdef SOLUTION_BITS_AVX2
+            if (this->size >= SOLUTION_WORD_BITS && __builtin_cpu_supports("avx2"))
+                return DotAvx2(values);
+#endif
+            return DotScalar(values);
+        }
+
+    private:
+        /**
+         * Zeroes bits behind the last one.
+         */
+        void ClearTail() {
+            if (this->size % SOLUTION_WORD_BITS != 0)
+                this->words.back() &= ((uint64_t)1 << (this->size % SOLUTION_WORD_BITS)) - 1;
+        }
+
+        long long DotScalar(const int * values) const {
+            long long sum = 0;
+
+            for (size_t j = 0; j < this->words.size(); ++j) {
+                // visits set bits only
+                for (uint64_t w = this->words[j]; w != 0; w &= w - 1)
+                    sum += values[j * SOLUTION_WORD_BITS + __builtin_ctzll(w)];
+            }
+
+            return sum;
+        }
+
+#ifdef SOLUTION_BITS_AVX2
+        /**
+         * Every byte of word selects lanes of 8 values, so masked values
+         * of whole word are summed by 8 vector steps.
+         */
+        __attribute__((target("avx2")))
+        long long DotAvx2(const int * values) const {
+            const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+            size_t full = this->size / SOLUTION_WORD_BITS;
+            long long sum = 0;
+
+            for (size_t j = 0; j < full; ++j) {
+                uint64_t w = this->words[j];
+                const int * v = values + j * SOLUTION_WORD_BITS;
+                __m256i acc = _mm256_setzero_si256();
+
+                if (w == 0)
+                    continue;
+
+                for (int b = 0; b < 8; ++b) {
+                    __m256i byte = _mm256_set1_epi32((w >> (8 * b)) & 0xff);
+                    __m256i mask = _mm256_cmpeq_epi32(_mm256_and_si256(byte, lanes), lanes);
+                    __m256i vals = _mm256_and_si256(_mm256_loadu_si256((const __m256i *)(v + 8 * b)), mask);
+
+                    // 64 bit lanes, sums of large values do not overflow
+                    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(vals)));
+                    acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(vals, 1)));
+                }
+
+                int64_t parts[4];
+
+                _mm256_storeu_si256((__m256i *)parts, acc);
+                sum += parts[0] + parts[1] + parts[2] + parts[3];
+            }
+
+            // the last partial word
+            if (full < this->words.size()) {
+                for (uint64_t w = this->words[full]; w != 0; w &= w - 1)
+                    sum += values[full * SOLUTION_WORD_BITS + __builtin_ctzll(w)];
+            }
+
+            return sum;
+        }
+#endif
+
+        size_t size;
+        std::vector<uint64_t> words;
+};
+
+namespace std {
+    template <>
+    struct hash<SolutionBits> {
+        size_t operator()(const SolutionBits & bits) const {
+            return bits.Hash();
+        }
+    };
+}
+
+#endif //SOLUTION_BITS_HH
@@ -44,13 +44,13 @@ void SolveTabuSearch(Instances * inst) {
     int max_volume = inst->GetVolume();
     //int max_items = inst->GetMaxItems();
 
-    std::vector<Instance *> all_instances =  inst->GetAllInstances();
+    const std::vector<Instance *> & all_instances = inst->GetAllInstances();
 
     // generate initial solutions
     auto population = InitializePopulation(20, 12); 
     PrintVectorBinaryVector(population);
 
-    std::vector<bool> solution;
+    SolutionBits solution;
 
     for (auto inst_it = all_instances.begin(); inst_it != all_instances.end(); ++inst_it) {
       //for (auto inst_it : all_instances)
@@ -62,10 +62,10 @@ void SolveTabuSearch(Instances * inst) {
 /**
  * Function operates the main parts of algorithm.
  */
-std::vector<bool> Evaluate(Instance * inst, 
-                           std::vector<std::vector<bool>> population, 
+SolutionBits Evaluate(Instance * inst, 
+                           std::vector<SolutionBits> population, 
                            int max_volume) {
-    std::vector<bool> solution;
+    SolutionBits solution;
 
     return solution;
 }
@@ -77,7 +77,7 @@ Population InitializePopulation(size_t length, int size) {
     Population population;
 
     for (int i = 0; i < size; ++i) {
-        std::vector<bool> tmp_bit_vector;
+        SolutionBits tmp_bit_vector;
 
         // random generate potential solution
         tmp_bit_vector = GenerateBinaryVector(length);
@@ -94,11 +94,11 @@ Population InitializePopulation(size_t length, int size) {
  * @param  solution  examined solution
  * @return           all neighbors
  */
-std::vector<std::vector<bool>> 
-GetNeighbors(std::vector<bool> solution, std::vector<std::vector<bool>> tabu) {
-    std::vector<std::vector<bool>> neighborhood;
-    std::vector<bool> tmp_neighbor;
-    int vector_size = solution.size();
+std::vector<SolutionBits> 
+GetNeighbors(SolutionBits solution, std::vector<SolutionBits> tabu) {
+    std::vector<SolutionBits> neighborhood;
+    SolutionBits tmp_neighbor;
+    int vector_size = solution.Size();
 
     for (int i = 0; i < vector_size; ++i) {
         tmp_neighbor = FlipBit(solution, i);
@@ -118,7 +118,7 @@ GetNeighbors(std::vector<bool> solution, std::vector<std::vector<bool>> tabu) {
  * @param  solution  examined potential solution
  * @return           boolean variable answering the question
  */
-bool IsTabu(std::vector<bool> solution, std::vector<std::vector<bool>> tabu) {
+bool IsTabu(SolutionBits solution, std::vector<SolutionBits> tabu) {
     for (auto t : tabu)
         if (CompareBits(solution, t))
             return true;
@@ -133,21 +133,14 @@ bool IsTabu(std::vector<bool> solution, std::vector<std::vector<bool>> tabu) {
  * @param  vb2  the second vector of bool values
  * @return      
  */
-bool CompareBits(std::vector<bool> vb1, std::vector<bool> vb2) {
+bool CompareBits(SolutionBits vb1, SolutionBits vb2) {
     // check the size of vectors
-    if (vb1.size() == vb2.size()) {
+    if (vb1.Size() == vb2.Size()) {
         std::cerr << "The size of vector is not equal!" << std::endl;
         exit(NOT_EQUAL);
     }
 
-    // gradual controling bits in vector
-    auto vb2_it = vb2.begin();
-    for (auto vb1_it = vb1.begin(); vb1_it != vb1.end(); ++vb1_it, ++vb2_it) {
-        if (*vb1_it != *vb2_it)
-            return false;
-    }
-
-    return true;
+    return vb1 == vb2;
 }
 
 
@@ -158,11 +151,8 @@ bool CompareBits(std::vector<bool> vb1, std::vector<bool> vb2) {
  * @param  position  position of bit, which changes
  * @return           changed binary vector
  */
-std::vector<bool> FlipBit(std::vector<bool> vb, int position) {
-    if (vb.at(position) == 1)
-        vb.at(position) = 0;
-    else
-        vb.at(position) = 1;
+SolutionBits FlipBit(SolutionBits vb, int position) {
+    vb.Flip(position);
 
     return vb;
 }
@@ -172,9 +162,9 @@ std::vector<bool> FlipBit(std::vector<bool> vb, int position) {
  *
  * @param  bv  binary vector
  */
-void PrintBinaryVector(std::vector<bool> bv) {
-    for (auto it = bv.begin(); it != bv.end(); ++it)
-        std::cout << *it;
+void PrintBinaryVector(SolutionBits bv) {
+    for (size_t i = 0; i < bv.Size(); ++i)
+        std::cout << bv.Get(i);
 
     std::cout << std::endl;
 }
@@ -182,7 +172,7 @@ void PrintBinaryVector(std::vector<bool> bv) {
 /**
  * Print vector of binary vectors.
  */
-void PrintVectorBinaryVector(std::vector<std::vector<bool>> bvv) {
+void PrintVectorBinaryVector(std::vector<SolutionBits> bvv) {
     for (auto bv : bvv)
         PrintBinaryVector(bv);
 }
@@ -190,11 +180,11 @@ void PrintVectorBinaryVector(std::vector<std::vector<bool>> bvv) {
 /**
  * Generates random binary vector.
  */
-std::vector<bool> GenerateBinaryVector(int length) {
-    std::vector<bool> bv;
+SolutionBits GenerateBinaryVector(int length) {
+    SolutionBits bv;
 
     for (int i = 0; i < length; ++i)
-        bv.push_back(rand()%2);
+        bv.PushBack(rand()%2);
 
     return bv;
 }
@@ -202,13 +192,13 @@ std::vector<bool> GenerateBinaryVector(int length) {
 /**
  *
  */
-std::vector<bool> BestNeighbor(Neighbors neighbors) {
+SolutionBits BestNeighbor(Neighbors neighbors) {
 }
 
 /**
  *
  */
-int EvaluateSolution(std::vector<bool> solution) {
+int EvaluateSolution(SolutionBits solution) {
     int ranking = 0;
 
     return ranking;
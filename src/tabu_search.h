@@ -16,22 +16,22 @@
 #define MIN_PARAM    3
 #define NOT_EQUAL    1
 
-typedef std::vector<std::vector<bool>> Population;
-typedef std::vector<std::vector<bool>> Neighbors;
+typedef std::vector<SolutionBits> Population;
+typedef std::vector<SolutionBits> Neighbors;
 
 void SolveTabuSearch(Instances * inst);
 Population InitializePopulation(size_t length, int size);
 
-bool IsTabu(std::vector<bool> solution, std::vector<std::vector<bool>> tabu);
-bool CompareBits(std::vector<bool> vb1, std::vector<bool> vb2);
-std::vector<bool> FlipBit(std::vector<bool> vb, int position);
-std::vector<std::vector<bool>> 
-GetNeighbors(std::vector<bool> solution, std::vector<std::vector<bool>> tabu);
-void PrintBinaryVector(std::vector<bool> * bv);
-void PrintVectorBinaryVector(std::vector<std::vector<bool>> bvv);
-std::vector<bool> GenerateBinaryVector(int length);
-std::vector<bool> Evaluate(Instance * inst, 
-                           std::vector<std::vector<bool>> population, 
+bool IsTabu(SolutionBits solution, std::vector<SolutionBits> tabu);
+bool CompareBits(SolutionBits vb1, SolutionBits vb2);
+SolutionBits FlipBit(SolutionBits vb, int position);
+std::vector<SolutionBits> 
+GetNeighbors(SolutionBits solution, std::vector<SolutionBits> tabu);
+void PrintBinaryVector(SolutionBits * bv);
+void PrintVectorBinaryVector(std::vector<SolutionBits> bvv);
+SolutionBits GenerateBinaryVector(int length);
+SolutionBits Evaluate(Instance * inst, 
+                           std::vector<SolutionBits> population, 
                            int max_volume);
 
 
@@ -54,7 +54,7 @@ void SolveTabuSearch(SatInstance & inst,
                      Settings & settings) {
 
     int solutionLength = inst.GetLength();
-    std::vector<bool> solution;
+    SolutionBits solution;
 
     // generate initial solutions
     auto population = InitializePopulation(settings); 
@@ -73,7 +73,7 @@ void Evaluate(SatInstance & inst,
 
     // create binary solution
     int solutionLength = inst.GetLength();
-    std::vector<bool> solution = ZeroSolution(solutionLength);
+    SolutionBits solution = ZeroSolution(solutionLength);
 
     // create temporary best state 
     State bestState = CreateState(solution);
@@ -106,7 +106,7 @@ void Evaluate(SatInstance & inst,
 
          tmp_next_population.clear();
 
-         for (auto popu_it : tmp_population) {
+         for (auto & popu_it : tmp_population) {
              neighbors = GetNeighbors(popu_it, tabu, vectorTabuClause, inst, settings);
              tmp_solution = BestNeighbor(inst, neighbors);
              tmp_next_population.push_back(tmp_solution.solution);
@@ -154,7 +154,7 @@ Population InitializePopulation(Settings & settings) {
     int solutionSize = settings.solutionSize;
 
     for (int i = 0; i < populationLength; ++i) {
-        std::vector<bool> tmp_bit_vector;
+        SolutionBits tmp_bit_vector;
 
         // random generate potential solution
         tmp_bit_vector = GenerateBinaryVector(solutionSize);
@@ -172,7 +172,7 @@ Population InitializePopulation(Settings & settings) {
  * @return           all neighbors
  */
 std::vector<State> 
-GetNeighbors(std::vector<bool> & solution, 
+GetNeighbors(SolutionBits & solution, 
              std::vector<Tabu> & tabu,
              std::vector<TabuClause> & vectorTabuClause,
              SatInstance & inst,
@@ -180,15 +180,20 @@ GetNeighbors(std::vector<bool> & solution,
 
     std::vector<State> neighborhood;
 
-    std::vector<bool> neighbor;
+    SolutionBits neighbor;
     State state;
-    int vectorSize = solution.size();
+    int vectorSize = solution.Size();
 
     std::vector<std::vector<int>> 
     combinations = CreateFlipCombinations(vectorSize,
                                           settings.neighborhoodSize);
 
-    for (auto comb_it : combinations) {
+    // clauses of examined solution are evaluated only once, neighbors
+    // update clauses containing flipped variables
+    std::vector<int> trueLiterals = CountTrueLiterals(inst, solution);
+    std::vector<int> violated = ViolatedClauses(trueLiterals);
+
+    for (const auto & comb_it : combinations) {
         neighbor = FlipPartBits(solution, comb_it);
 
 #ifdef TABU_CLAUSE
@@ -197,8 +202,11 @@ GetNeighbors(std::vector<bool> & solution,
         if (!IsTabu(neighbor, tabu)) {
             AddOneTabu(neighbor, tabu, settings.duration);
 #endif
-            state = SolveBooleanFormula(inst, 
+            state = SolveFlippedFormula(inst, 
                                         neighbor, 
+                                        comb_it,
+                                        trueLiterals,
+                                        violated,
                                         vectorTabuClause, 
                                         settings.duration);
 
@@ -216,8 +224,8 @@ GetNeighbors(std::vector<bool> & solution,
  * @param  solution  examined potential solution
  * @return           boolean variable answering the question
  */
-bool IsTabu(std::vector<bool> solution, std::vector<Tabu> tabu) {
-    for (auto t : tabu)
+bool IsTabu(const SolutionBits & solution, const std::vector<Tabu> & tabu) {
+    for (const auto & t : tabu)
         if (CompareBits(solution, t.solution))
             return true;
 
@@ -231,21 +239,14 @@ bool IsTabu(std::vector<bool> solution, std::vector<Tabu> tabu) {
  * @param  vb2  the second vector of bool values
  * @return      
  */
-bool CompareBits(std::vector<bool> vb1, std::vector<bool> vb2) {
+bool CompareBits(const SolutionBits & vb1, const SolutionBits & vb2) {
     // check the size of vectors
-    if (vb1.size() != vb2.size()) {
+    if (vb1.Size() != vb2.Size()) {
         std::cerr << "The size of vector is not equal!" << std::endl;
         exit(NOT_EQUAL);
     }
 
-    // gradual controling bits in vector
-    auto vb2_it = vb2.begin();
-    for (auto vb1_it = vb1.begin(); vb1_it != vb1.end(); ++vb1_it, ++vb2_it) {
-        if (*vb1_it != *vb2_it)
-            return false;
-    }
-
-    return true;
+    return vb1 == vb2;
 }
 
 /**
@@ -255,11 +256,8 @@ bool CompareBits(std::vector<bool> vb1, std::vector<bool> vb2) {
  * @param  position  position of bit, which changes
  * @return           changed binary vector
  */
-std::vector<bool> FlipBit(std::vector<bool> vb, int position) {
-    if (vb.at(position) == 1)
-        vb.at(position) = 0;
-    else
-        vb.at(position) = 1;
+SolutionBits FlipBit(SolutionBits vb, int position) {
+    vb.Flip(position);
 
     return vb;
 }
@@ -269,9 +267,9 @@ std::vector<bool> FlipBit(std::vector<bool> vb, int position) {
  *
  * @param  bv  binary vector
  */
-void PrintBinaryVector(std::vector<bool> bv) {
-    for (auto it = bv.begin(); it != bv.end(); ++it)
-        std::cout << *it;
+void PrintBinaryVector(const SolutionBits & bv) {
+    for (size_t i = 0; i < bv.Size(); ++i)
+        std::cout << bv.Get(i);
 
     std::cout << std::endl;
 }
@@ -279,11 +277,11 @@ void PrintBinaryVector(std::vector<bool> bv) {
 /**
  * Generates random binary vector.
  */
-std::vector<bool> GenerateBinaryVector(int length) {
-    std::vector<bool> bv;
+SolutionBits GenerateBinaryVector(int length) {
+    SolutionBits bv;
 
     for (int i = 0; i < length; ++i)
-        bv.push_back(rand()%2);
+        bv.PushBack(rand()%2);
 
     return bv;
 }
@@ -299,20 +297,20 @@ BestNeighbor(SatInstance & inst, std::vector<State> & neighbors) {
     // keep eye on
     // set best solution as the empty binary vector
     if (neighbors.size() == 0) {
-        std::vector<bool> tmpSolution = ZeroSolution(inst.GetLength()); 
+        SolutionBits tmpSolution = ZeroSolution(inst.GetLength()); 
         bestSolution = CreateState(tmpSolution); 
     }
     else
         bestSolution = neighbors.at(0);
 
-    for (auto neighbor : neighbors)
+    for (auto & neighbor : neighbors)
         bestSolution = CompareStates(bestSolution, neighbor);
 
     return bestSolution;
 }
 
 State SolveBooleanFormula(SatInstance & inst, 
-                          std::vector<bool> & solution,
+                          SolutionBits & solution,
                           std::vector<TabuClause> & vectorTabuClause,
                           int duration) {
 
@@ -321,18 +319,19 @@ State SolveBooleanFormula(SatInstance & inst,
     bool violated = false;
 
     // tabu clause
-    int size = solution.size();
+    int size = solution.Size();
     TabuClause tabuClause;
 
-    for (auto bf_it : inst.formula) {
-        result = SolveClause(bf_it, solution);
+    for (int i = 0; i < inst.formula.Size(); ++i) {
+        ClauseView clause = inst.formula.Clause(i);
+        result = SolveClause(clause, solution);
 
         if (!result) {
             state.numberViolated++;
             violated = true;
 
 #ifdef TABU_CLAUSE
-            tabuClause = CreateTabuClause(bf_it, size, duration);
+            tabuClause = CreateTabuClause(clause, size, duration);
             AddTabuClause(vectorTabuClause, tabuClause);
 #endif
         }
@@ -346,12 +345,127 @@ State SolveBooleanFormula(SatInstance & inst,
     return state;
 }
 
-bool SolveClause(Clause & c, std::vector<bool> & solution) {
+/**
+ * Evaluates neighbor which differs from examined solution in flipped
+ * positions. Only clauses from occurrence lists of flipped variables are
+ * visited, the rest keeps its state from examined solution.
+ *
+ * @param  neighbor      evaluated neighbor
+ * @param  flipped       positions flipped in examined solution
+ * @param  trueLiterals  number of true literals in every clause of examined solution
+ * @param  violated      sorted violated clauses of examined solution
+ * @return               state of neighbor
+ */
+State SolveFlippedFormula(SatInstance & inst, 
+                          SolutionBits & neighbor,
+                          const std::vector<int> & flipped,
+                          const std::vector<int> & trueLiterals,
+                          const std::vector<int> & violated,
+                          std::vector<TabuClause> & vectorTabuClause,
+                          int duration) {
+
+    State state = CreateState(neighbor);
+
+    // collect changes of true literals in touched clauses
+    std::vector<std::pair<int, int>> changes;
+
+    for (auto position : flipped) {
+        int variable = position + 1;
+        int delta = neighbor.Get(position) ? 1 : -1;
+        ClauseView positive = inst.formula.Positive(variable);
+        ClauseView negative = inst.formula.Negative(variable);
+
+        for (const int * c = positive.begin; c != positive.end; ++c)
+            changes.push_back(std::make_pair(*c, delta));
+
+        for (const int * c = negative.begin; c != negative.end; ++c)
+            changes.push_back(std::make_pair(*c, -delta));
+    }
+
+    std::sort(changes.begin(), changes.end());
+
+    // merge touched clauses with violated clauses of examined solution
+    std::vector<int> violatedNeighbor;
+    auto v_it = violated.begin();
+    auto ch_it = changes.begin();
+
+    while (ch_it != changes.end()) {
+        int clause = ch_it->first;
+        int count = trueLiterals[clause];
+
+        for (; ch_it != changes.end() && ch_it->first == clause; ++ch_it)
+            count += ch_it->second;
+
+        for (; v_it != violated.end() && *v_it < clause; ++v_it)
+            violatedNeighbor.push_back(*v_it);
+
+        if (v_it != violated.end() && *v_it == clause)
+            ++v_it;
+
+        if (count == 0)
+            violatedNeighbor.push_back(clause);
+    }
+
+    violatedNeighbor.insert(violatedNeighbor.end(), v_it, violated.end());
+
+    state.numberViolated = violatedNeighbor.size();
+
+#ifdef TABU_CLAUSE
+    int size = neighbor.Size();
+    TabuClause tabuClause;
+
+    for (auto clause : violatedNeighbor) {
+        tabuClause = CreateTabuClause(inst.formula.Clause(clause), size, duration);
+        AddTabuClause(vectorTabuClause, tabuClause);
+    }
+#endif
+
+    if (violatedNeighbor.empty())
+        state.weightSum = CountWeights(neighbor, inst.weights);
+    else
+        state.weightSum = INVALID_SOLUTION;
+
+    return state;
+}
+
+/**
+ * Counts true literals in every clause of formula.
+ */
+std::vector<int> CountTrueLiterals(SatInstance & inst, 
+                                   SolutionBits & solution) {
+
+    std::vector<int> trueLiterals(inst.formula.Size(), 0);
+
+    for (int i = 0; i < inst.formula.Size(); ++i) {
+        ClauseView clause = inst.formula.Clause(i);
+
+        for (const int * c_it = clause.begin; c_it != clause.end; ++c_it)
+            if (EvaluateBool(*c_it, solution))
+                trueLiterals[i]++;
+    }
+
+    return trueLiterals;
+}
+
+/**
+ * Selects clauses without any true literal.
+ */
+std::vector<int> ViolatedClauses(const std::vector<int> & trueLiterals) {
+    std::vector<int> violated;
+
+    for (int i = 0; i < (int)trueLiterals.size(); ++i)
+        if (trueLiterals[i] == 0)
+            violated.push_back(i);
+
+    return violated;
+}
+
+bool SolveClause(const ClauseView & c, SolutionBits & solution) {
     bool result = false;
     bool tmp_bool;
 
-    for (auto c_it : c) {
-        tmp_bool = EvaluateBool(c_it, solution);
+    for (const int * c_it = c.begin; c_it != c.end; ++c_it) {
+        tmp_bool = EvaluateBool(*c_it, solution);
         result = Or(result, tmp_bool);
     }
 
@@ -365,8 +479,8 @@ bool Or(bool b1, bool b2) {
         return false;
 }
 
-bool EvaluateBool(int p, std::vector<bool> & solution) {
-    bool b = solution.at(std::abs(p)-1);
+bool EvaluateBool(int p, SolutionBits & solution) {
+    bool b = solution.Get(std::abs(p)-1);
 
     if (p < 0)
         return FlipBool(b);
@@ -433,7 +547,7 @@ void AddTabu(Population & population,
 
     Tabu tmp_tabu;
 
-    for (auto pop_it : population) {
+    for (const auto & pop_it : population) {
         if (!IsTabu(pop_it, tabu)) {
             tmp_tabu = CreateTabu(pop_it, duration);
             tabu.push_back(tmp_tabu);
@@ -444,7 +558,7 @@ void AddTabu(Population & population,
 /**
  * Adds one solution to tabu list.
  */
-void AddOneTabu(std::vector<bool> solution, 
+void AddOneTabu(const SolutionBits & solution, 
                 std::vector<Tabu> & tabu,
                 int duration) {
 
@@ -456,7 +570,7 @@ void AddOneTabu(std::vector<bool> solution,
 /**
  * Creates and fills Tabu struct.
  */
-Tabu CreateTabu(std::vector<bool> solution, int duration) {
+Tabu CreateTabu(const SolutionBits & solution, int duration) {
     Tabu tabu;
     tabu.solution = solution;
     tabu.duration = duration;
@@ -466,14 +580,8 @@ Tabu CreateTabu(std::vector<bool> solution, int duration) {
 /**
  *  Creates vector of zeros of given length.
  */
-std::vector<bool> ZeroSolution(int length) {
-    std::vector<bool> zeros;
-
-    for (int i = 0; i < length; ++i ) {
-        zeros.push_back(0);
-    }
-
-    return zeros;
+SolutionBits ZeroSolution(int length) {
+    return SolutionBits(length);
 }
 
 State CompareStates(State & s1, State & s2) {
@@ -496,7 +604,7 @@ State LowerViolated(State & s1, State & s2) {
         return s2;
 }
 
-State CreateState(std::vector<bool> & solution) {
+State CreateState(SolutionBits & solution) {
     State s;
     s.solution = solution;
     s.numberViolated = 0;
@@ -505,24 +613,14 @@ State CreateState(std::vector<bool> & solution) {
     return s;
 }
 
-int CountWeights(std::vector<bool> & solution, std::vector<int> & weights) {
-    int weightSum = 0;
-
-    auto w_it = weights.begin();
-    for (auto s_it : solution) {
-        if (s_it)
-            weightSum += *w_it;
-
-        w_it++;    
-    }
-
-    return weightSum;
+int CountWeights(SolutionBits & solution, std::vector<int> & weights) {
+    return solution.Dot(weights.data());
 }
 
 
 void PrintBest(State & best) {
-    for (auto s : best.solution)
-        std::cout << s;
+    for (size_t i = 0; i < best.solution.Size(); ++i)
+        std::cout << best.solution.Get(i);
 
     std::cout << std::endl;
 
@@ -531,8 +629,10 @@ void PrintBest(State & best) {
 }
 
 void PrintSuboptimal(SatInstance & inst) {
-    for (auto s : inst.GetSuboptimalSolution())
-        std::cout << s;
+    SolutionBits suboptimal = inst.GetSuboptimalSolution();
+
+    for (size_t i = 0; i < suboptimal.Size(); ++i)
+        std::cout << suboptimal.Get(i);
 
     std::cout << std::endl;
 
@@ -551,37 +651,37 @@ bool UnitTests() {
     // Unit 0
     SatInstance si = SatInstance("../data-sat/sat0.dat");
 
-    std::vector<bool> s1 = {0, 0, 0, 1};
+    SolutionBits s1 = StringToSolution("0001");
     State u1 = SolveBooleanFormula(si, s1, vectorTabuClause, d);
     result &= UnitTestEvaluate(1, u1, 6, 0);
 
-    std::vector<bool> s2 = {1, 0, 0, 1};
+    SolutionBits s2 = StringToSolution("1001");
     State u2 = SolveBooleanFormula(si, s2, vectorTabuClause, d);
     result &= UnitTestEvaluate(2, u2, 8, 0);
 
-    std::vector<bool> s3 = {1, 1, 1, 0};
+    SolutionBits s3 = StringToSolution("1110");
     State u3 = SolveBooleanFormula(si, s3, vectorTabuClause, d);
     result &= UnitTestEvaluate(3, u3, 7, 0);
 
-    std::vector<bool> s4 = {1, 1, 1, 1};
+    SolutionBits s4 = StringToSolution("1111");
     State u4 = SolveBooleanFormula(si, s4, vectorTabuClause, d);
     result &= UnitTestEvaluate(4, u4, INVALID_SOLUTION, 1);
 
     // Unit 1
     si = SatInstance("../data-sat/sat1.dat");
-    std::vector<bool> s5 = {0, 1, 1, 0, 1, 0};
+    SolutionBits s5 = StringToSolution("011010");
     State u5 = SolveBooleanFormula(si, s5, vectorTabuClause, d);
     result &= UnitTestEvaluate(5, u5, 11, 0);
 
     // Unit 2
     si = SatInstance("../data-sat/sat2.dat");
-    std::vector<bool> s6 = {0, 1, 0, 1, 1, 0, 1, 1, 0, 0, 0, 1, 0, 0, 1};
+    SolutionBits s6 = StringToSolution("010110110001001");
     State u6 = SolveBooleanFormula(si, s6, vectorTabuClause, d);
     result &= UnitTestEvaluate(6, u6, 43, 0);
 
     // Unit 3
     si = SatInstance("../data-sat/sat3.dat");
-    std::vector<bool> s7 = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1};
+    SolutionBits s7 = StringToSolution("111111111110111");
     State u7 = SolveBooleanFormula(si, s7, vectorTabuClause, d);
     result &= UnitTestEvaluate(7, u7, 77, 0);
 
@@ -609,43 +709,44 @@ bool UnitTestEvaluate(int id,
 /**
  * Checks if binaryVector contains pattern at particular positions.
  */
-bool EqualTabuClause(TabuClause & input, 
-                     TabuClause & pattern) {
+bool EqualTabuClause(const TabuClause & input, 
+                     const TabuClause & pattern) {
     
     if (!CompareBits(input.position, pattern.position))
         return false;
 
-    bool equal = true;
-    
-    auto in_it = input.clause.begin();
-    auto pa_it = pattern.clause.begin();
-
-    for (auto pos_it : input.position) {
-       if (pos_it == 1) {
-           if (*in_it == *pa_it)
-               equal &= true;
-           else
-               equal &= false;
-       }
-
-       in_it++;
-       pa_it++;
-    }
+    return EqualAtPositions(input.clause, pattern.clause, input.position);
+}
+
+/**
+ * Checks if two binary vectors agree at given positions.
+ */
+bool EqualAtPositions(const SolutionBits & input,
+                      const SolutionBits & pattern,
+                      const SolutionBits & position) {
+
+    const uint64_t * in = input.Words();
+    const uint64_t * pa = pattern.Words();
+    const uint64_t * pos = position.Words();
+
+    for (size_t i = 0; i < position.WordCount(); ++i)
+        if ((in[i] ^ pa[i]) & pos[i])
+            return false;
 
-    return equal;
+    return true;
 }
 
 /**
  * Creates binary vector which determines particular clause.
  */
-std::vector<bool> 
-CreateClauseBinaryVector(std::vector<int> & positions, 
+SolutionBits 
+CreateClauseBinaryVector(const ClauseView & positions, 
                          int length) {
 
-    std::vector<bool> positionBinaryVector = ZeroSolution(length);
+    SolutionBits positionBinaryVector = ZeroSolution(length);
 
-    for (auto p_it : positions)
-        if (p_it > 0) { positionBinaryVector.at(std::abs(p_it)-1) = 1; }
+    for (const int * p_it = positions.begin; p_it != positions.end; ++p_it)
+        if (*p_it > 0) { positionBinaryVector.Set(std::abs(*p_it)-1, true); }
 
     return positionBinaryVector;
 }
@@ -653,14 +754,14 @@ CreateClauseBinaryVector(std::vector<int> & positions,
 /**
  * Creates binary vector in which the ones determines positions in binary vector.
  */
-std::vector<bool> 
-CreatePositionBinaryVector(std::vector<int> & positions, 
+SolutionBits 
+CreatePositionBinaryVector(const ClauseView & positions, 
                            int length) {
 
-    std::vector<bool> positionBinaryVector = ZeroSolution(length);
+    SolutionBits positionBinaryVector = ZeroSolution(length);
 
-    for (auto p_it : positions)
-        positionBinaryVector.at(std::abs(p_it)-1) = 1;
+    for (const int * p_it = positions.begin; p_it != positions.end; ++p_it)
+        positionBinaryVector.Set(std::abs(*p_it)-1, true);
 
     return positionBinaryVector;
 }
@@ -668,10 +769,10 @@ CreatePositionBinaryVector(std::vector<int> & positions,
 /**
  * Compares given clause tabu clauses.
  */
-bool IsTabuClause(std::vector<TabuClause> & tabu, 
-                  TabuClause & clause) {
+bool IsTabuClause(const std::vector<TabuClause> & tabu, 
+                  const TabuClause & clause) {
 
-    for (auto t_it : tabu)
+    for (const auto & t_it : tabu)
        if (EqualTabuClause(t_it, clause))
            return true;
 
@@ -692,7 +793,7 @@ void AddTabuClause(std::vector<TabuClause> & tabu,
  * Creates a tabu clause with all its attributes and intialize them.
  */
 TabuClause 
-CreateTabuClause(std::vector<int> & clause,
+CreateTabuClause(const ClauseView & clause,
                  int size,
                  int duration) {
 
@@ -707,15 +808,12 @@ CreateTabuClause(std::vector<int> & clause,
 /**
  * Checks if given solution doesnt consist from tabu clauses.
  */
-bool IsSolutionInTabuClause(std::vector<bool> solution,
-                            std::vector<TabuClause> tabuClause) {
-
-    TabuClause simpleTc;
+bool IsSolutionInTabuClause(const SolutionBits & solution,
+                            const std::vector<TabuClause> & tabuClause) {
 
-    for (auto tc_it : tabuClause) {
-        simpleTc = CreateSimpleTabuClause(solution, tc_it.position, 0);
-
-        if (EqualTabuClause(simpleTc, tc_it)) 
+    // solution takes positions of tabu clause, so only clauses are compared
+    for (const auto & tc_it : tabuClause) {
+        if (EqualAtPositions(solution, tc_it.clause, tc_it.position)) 
             return true;
     }
 
@@ -723,8 +821,8 @@ bool IsSolutionInTabuClause(std::vector<bool> solution,
 }
 
 TabuClause 
-CreateSimpleTabuClause(std::vector<bool> & clause,
-                       std::vector<bool> & position, 
+CreateSimpleTabuClause(const SolutionBits & clause,
+                       const SolutionBits & position, 
                        int duration) {
 
     TabuClause tc;
@@ -779,13 +877,25 @@ CreateFlipCombinations(int length,
     return positions;
 }
 
-std::vector<bool> FlipPartBits(std::vector<bool> solution,
-                               std::vector<int> combinations) {
+SolutionBits FlipPartBits(const SolutionBits & solution,
+                          const std::vector<int> & combinations) {
 
-    std::vector<bool> flippedSolution = solution;
+    SolutionBits flippedSolution = solution;
 
     for (auto comb_it : combinations)
-        flippedSolution = FlipBit(flippedSolution, comb_it);
+        flippedSolution.Flip(comb_it);
 
     return flippedSolution;
 }
+
+/**
+ * Creates solution from string of zeros and ones, e.g. "0110".
+ */
+SolutionBits StringToSolution(const std::string & bits) {
+    SolutionBits solution;
+
+    for (auto b : bits)
+        solution.PushBack(b == '1');
+
+    return solution;
+}
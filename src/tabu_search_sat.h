@@ -15,15 +15,15 @@
 #include <random>
 #include <stdlib.h>
 
-typedef std::vector<std::vector<bool>> Population;
-typedef std::vector<std::vector<bool>> Neighbors;
+typedef std::vector<SolutionBits> Population;
+typedef std::vector<SolutionBits> Neighbors;
 
 const int INVALID_SOLUTION = -1;
 const int MIN_PARAM        =  1;
 const int NOT_EQUAL        =  1;
 
 struct State {
-    std::vector<bool> solution;
+    SolutionBits solution;
     int numberViolated;
     int weightSum;
 };
@@ -37,13 +37,13 @@ struct Settings {
 };
 
 struct Tabu {
-    std::vector<bool> solution;
+    SolutionBits solution;
     int duration;
 };
 
 struct TabuClause {
-    std::vector<bool> clause;
-    std::vector<bool> position;
+    SolutionBits clause;
+    SolutionBits position;
     int duration;
 };
 
@@ -51,23 +51,23 @@ void SolveTabuSearch(SatInstance & inst, Settings & settings);
 
 Population InitializePopulation(Settings & settings);
 
-bool IsTabu(std::vector<bool> solution, std::vector<Tabu> tabu);
+bool IsTabu(const SolutionBits & solution, const std::vector<Tabu> & tabu);
 
-bool CompareBits(std::vector<bool> vb1, std::vector<bool> vb2);
+bool CompareBits(const SolutionBits & vb1, const SolutionBits & vb2);
 
-std::vector<bool> FlipBit(std::vector<bool> vb, int position);
+SolutionBits FlipBit(SolutionBits vb, int position);
 
 std::vector<State> 
-GetNeighbors(std::vector<bool> & solution, 
+GetNeighbors(SolutionBits & solution, 
              std::vector<Tabu> & tabu,
              std::vector<TabuClause> & vectorTabuClause,
              SatInstance & inst,
              Settings & settings);
 
-void PrintBinaryVector(std::vector<bool>  bv);
-void PrintVectorBinaryVector(std::vector<std::vector<bool>> bvv);
+void PrintBinaryVector(const SolutionBits & bv);
+void PrintVectorBinaryVector(const std::vector<SolutionBits> & bvv);
 
-std::vector<bool> GenerateBinaryVector(int length);
+SolutionBits GenerateBinaryVector(int length);
 
 void Evaluate(SatInstance & inst, 
               Population population, 
@@ -86,30 +86,43 @@ void AddTabu(Population & population,
              std::vector<Tabu> & tabu, 
              int duration);
 
-void AddOneTabu(std::vector<bool> solution, 
+void AddOneTabu(const SolutionBits & solution, 
                 std::vector<Tabu> & tabu,
                 int duration);
 
-Tabu CreateTabu(std::vector<bool> solution, int duration);
+Tabu CreateTabu(const SolutionBits & solution, int duration);
 
-std::vector<bool> ZeroSolution(int length);
+SolutionBits ZeroSolution(int length);
 
 State SolveBooleanFormula(SatInstance & inst, 
-                          std::vector<bool> & solution,
+                          SolutionBits & solution,
                           std::vector<TabuClause> & vectorTabuClause,
                           int duration);
 
 bool FlipBool(bool b);
 
-bool EvaluateBool(int p, std::vector<bool> & solution);
+bool EvaluateBool(int p, SolutionBits & solution);
 
 bool Or(bool b1, bool b2);
 
-bool SolveClause(Clause & c, std::vector<bool> & solution);
+bool SolveClause(const ClauseView & c, SolutionBits & solution);
 
-State CreateState(std::vector<bool> & solution);
+State SolveFlippedFormula(SatInstance & inst, 
+                          SolutionBits & neighbor,
+                          const std::vector<int> & flipped,
+                          const std::vector<int> & trueLiterals,
+                          const std::vector<int> & violated,
+                          std::vector<TabuClause> & vectorTabuClause,
+                          int duration);
+
+std::vector<int> CountTrueLiterals(SatInstance & inst, 
+                                   SolutionBits & solution);
+
+std::vector<int> ViolatedClauses(const std::vector<int> & trueLiterals);
 
-int CountWeights(std::vector<bool> & solution, std::vector<int> & weights);
+State CreateState(SolutionBits & solution);
+
+int CountWeights(SolutionBits & solution, std::vector<int> & weights);
 
 State CompareStates(State & s1, State & s2);
 
@@ -128,35 +141,39 @@ bool UnitTestEvaluate(int id,
                       int weightSum, 
                       int numberViolated);
 
-std::vector<bool> 
-CreatePositionBinaryVector(std::vector<int> & positions, 
+SolutionBits 
+CreatePositionBinaryVector(const ClauseView & positions, 
                            int length);
 
-bool IsTabuClause(std::vector<TabuClause> & tabu, 
-                  TabuClause & clause);
+bool IsTabuClause(const std::vector<TabuClause> & tabu, 
+                  const TabuClause & clause);
 
 void AddTabuClause(std::vector<TabuClause> & tabu, 
                    TabuClause & clause);
 
-bool EqualTabuClause(TabuClause & input, 
-                     TabuClause & pattern);
+bool EqualTabuClause(const TabuClause & input, 
+                     const TabuClause & pattern);
+
+bool EqualAtPositions(const SolutionBits & input,
+                      const SolutionBits & pattern,
+                      const SolutionBits & position);
 
 TabuClause 
-CreateTabuClause(std::vector<int> & clause,
+CreateTabuClause(const ClauseView & clause,
                  int size,
                  int duration);
 
-std::vector<bool> 
-CreateClauseBinaryVector(std::vector<int> & positions, 
+SolutionBits 
+CreateClauseBinaryVector(const ClauseView & positions, 
                          int length);
 
 TabuClause 
-CreateSimpleTabuClause(std::vector<bool> & clause,
-                       std::vector<bool> & position, 
+CreateSimpleTabuClause(const SolutionBits & clause,
+                       const SolutionBits & position, 
                        int duration);
 
-bool IsSolutionInTabuClause(std::vector<bool> solution,
-                            std::vector<TabuClause> tabuClause);
+bool IsSolutionInTabuClause(const SolutionBits & solution,
+                            const std::vector<TabuClause> & tabuClause);
 
 void comb(int n, 
           int r, 
@@ -168,7 +185,9 @@ std::vector<std::vector<int>>
 CreateFlipCombinations(int length, 
                        int neighborhoodSize);
 
-std::vector<bool> FlipPartBits(std::vector<bool> solution,
-                               std::vector<int> combinations);
+SolutionBits FlipPartBits(const SolutionBits & solution,
+                          const std::vector<int> & combinations);
+
+SolutionBits StringToSolution(const std::string & bits);
 
 #endif //TABU_SEARCH_SAT_H
@@ -0,0 +1,208 @@
+/**
+ * @file
+ * @author Martin Kersner <m.kersner@gmail.com>
+ * @date 10/17/2026
+ */
+
+#ifndef WORK_STEALING_HH
+#define WORK_STEALING_HH
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Pool of threads where every thread has its own queue of tasks. Thread
+ * takes tasks from the back of its queue and when its queue is empty, it
+ * steals tasks from the front of queues of other threads. Tasks submitted
+ * by a worker go to its own queue, other tasks are distributed round robin.
+ */
+class WorkStealingPool {
+    public:
+        /**
+         * Task gets index of worker which executes it.
+         */
+        typedef std::function<void(int worker)> Task;
+
+        /**
+         * Constructor. Starts workers.
+         *
+         * @param  threads  number of workers, 0 for all cores
+         */
+        WorkStealingPool(int threads) : pending(0), queued(0), stop(false), next(0) {
+            if (threads <= 0)
+                threads = std::thread::hardware_concurrency();
+
+            if (threads <= 0)
+                threads = 1;
+
+            for (int i = 0; i < threads; ++i)
+                this->queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue));
+
+            for (int i = 0; i < threads; ++i)
+                this->workers.push_back(std::thread(&WorkStealingPool::Run, this, i));
+        }
+
+        /**
+         * Destructor. Waits for workers, tasks which were not started are dropped.
+         */
+        ~WorkStealingPool() {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->stop = true;
+                this->has_work.notify_all();
+            }
+
+            for (auto & worker : this->workers)
+                worker.join();
+        }
+
+        /**
+         * Number of workers.
+         */
+        int Size() const {
+            return this->queues.size();
+        }
+
+        /**
+         * Adds task to pool.
+         *
+         * @param  task  added task
+         */
+        void Submit(Task task) {
+            int worker = CurrentWorker(this);
+
+            if (worker < 0)
+                worker = this->next++ % this->queues.size();
+
+            this->pending++;
+
+            {
+                std::unique_lock<std::mutex> lock(this->queues[worker]->mutex);
+                this->queues[worker]->tasks.push_back(task);
+            }
+
+            this->queued++;
+
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->has_work.notify_one();
+        }
+
+        /**
+         * Waits until all submitted tasks including tasks submitted by
+         * other tasks are finished. Must not be called from worker.
+         */
+        void Wait() {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->done.wait(lock, [this] { return this->pending == 0; });
+        }
+
+    private:
+        struct WorkerQueue {
+            std::deque<Task> tasks;
+            std::mutex mutex;
+        };
+
+        /**
+         * Index of worker of given pool running on current thread.
+         *
+         * @param   pool  pool which is asked for or stored together with set
+         * @param   set   index stored for current thread, -1 to only ask
+         * @return        index of worker, -1 if current thread is not worker of pool
+         */
+        static int CurrentWorker(const WorkStealingPool * pool, int set = -1) {
+            static thread_local const WorkStealingPool * current_pool = NULL;
+            static thread_local int current_worker = -1;
+
+            if (set >= 0) {
+                current_pool = pool;
+                current_worker = set;
+            }
+
+            return (current_pool == pool) ? current_worker : -1;
+        }
+
+        /**
+         * Main loop of worker.
+         *
+         * @param  worker  index of worker
+         */
+        void Run(int worker) {
+            CurrentWorker(this, worker);
+            Task task;
+
+            while (true) {
+                if (Take(worker, &task)) {
+                    task(worker);
+                    task = Task();
+
+                    if (--this->pending == 0) {
+                        std::unique_lock<std::mutex> lock(this->mutex);
+                        this->done.notify_all();
+                    }
+
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->has_work.wait(lock, [this] { return this->stop || this->queued > 0; });
+
+                if (this->stop)
+                    return;
+            }
+        }
+
+        /**
+         * Takes task from own queue or steals it from other worker.
+         *
+         * @param   worker  index of worker
+         * @param   task    taken task
+         * @return          false if all queues are empty
+         */
+        bool Take(int worker, Task * task) {
+            int size = this->queues.size();
+
+            for (int i = 0; i < size; ++i) {
+                WorkerQueue & queue = *this->queues[(worker + i) % size];
+                std::unique_lock<std::mutex> lock(queue.mutex);
+
+                if (queue.tasks.empty())
+                    continue;
+
+                // own tasks are taken in LIFO order, stolen ones in FIFO order
+                if (i == 0) {
+                    *task = queue.tasks.back();
+                    queue.tasks.pop_back();
+                }
+                else {
+                    *task = queue.tasks.front();
+                    queue.tasks.pop_front();
+                }
+
+                this->queued--;
+
+                return true;
+            }
+
+            return false;
+        }
+
+        std::vector<std::unique_ptr<WorkerQueue>> queues;
+        std::vector<std::thread> workers;
+
+        std::atomic<size_t> pending;  // submitted and not finished tasks
+        std::atomic<size_t> queued;   // tasks waiting in queues
+        bool stop;
+        std::atomic<size_t> next;     // queue of next task submitted from outside
+
+        std::mutex mutex;
+        std::condition_variable has_work;
+        std::condition_variable done;
+};
+
+#endif //WORK_STEALING_HH